@@ -1,49 +1,33 @@
 
 #include "DecoderRoman.h"
+#include "../Common/Profile.hpp"
+#include <numeric>
+#include <type_traits>
 
 /**
  * @brief Esta função recebe como entrada um cromossomo e tenta reduzir o peso da solução 
  * realizando algumas trocas válidas:
- * - se uv in E(G) e f(u)=2 e f(v)=1, então redefinimos o peso de v como f(v)=0.
- * - se u tem degree(u)>=2 e f(u)=1 e u tem pelo menos 2 vizinhos w com f(w)=1, então redefinimos 
- *   o peso de u como f(u)=2 e os seus vizinhos com rótulo 1 recebem rótulo 0..
+ * - se u tem f(u)=2 e não é o único vizinho com rótulo 2 de nenhum vizinho com rótulo 0,
+ *   então redefinimos f(u)=1.
+ * - se f(v)=1 e v tem exatamente um vizinho com rótulo 2, então redefinimos f(v)=0.
+ * As regras ficam em RepairEngine (Common/Repair.hpp), compartilhado com o GA.
  */
-void reduce_weight_heuristic(const Graph& graph, std::vector<int>& label, std::vector<int>& dominanceNumber) {
-    const int n = graph.getOrder();
-    for(int u = 0; u < n; u++){
-        if(label[u] == 2){
-            // Verificar se u é um dominador privado de algum de seus vizinhos
-            bool safe = true;
-            for(int v : graph.getNeighbors(u)){
-                if(label[v] == 0 && dominanceNumber[v] == 1){
-                    safe = false;
-                    break;
-                }
-            }
-
-            if(safe){
-                // Trocar o rotulo de 2 para 1
-                label[u] = 1;
-                // Corrije o dominanceNumber dos vizinhos de u
-                for(int v : graph.getNeighbors(u)){
-                    dominanceNumber[v]--;
-                }
-            }
-        }
-    }
+void reduce_weight_heuristic(const Adjacency& adj, Labelling& label, std::vector<int>& dominanceNumber) {
+    RepairEngine engine(adj);
+    engine.adopt(std::move(label), std::move(dominanceNumber));
+    engine.reduce();
+    label = std::move(engine.takeLabels());
+    dominanceNumber = engine.counts();
+}
 
-    // Para todo vertice com rotulo 1
-    // se ele for dominado por si e outro vertice com rotulo 2
-    // entao ele pode ter rotulo 0
-    for(int u = 0; u < n; u++){
-        if(label[u] == 1 && dominanceNumber[u] == 2){
-            label[u] = 0;
-            dominanceNumber[u]--;
-        }
+DecoderRoman::DecoderRoman(const Graph& graph) : g{graph}, adj(graph.getOrder()) {
+    for(size_t u = 0; u < adj.size(); u++){
+        adj[u].assign(g.getNeighbors(u).begin(), g.getNeighbors(u).end());
     }
+    bounded = boundedAdjacency(adj);
 }
 
-void checkPRD(const Graph& g, const std::vector<int>& f){
+void checkPRD(const Graph& g, const Labelling& f){
     int n = g.getOrder();
     for(int u = 0; u < n; u++){
         if(f[u] == 0){
@@ -65,73 +49,255 @@ void checkPRD(const Graph& g, const std::vector<int>& f){
     }
 }
 
+namespace {
+
+// Vizinhos visitados pelos kernels abaixo: a lista de u ou, com grau limitado,
+// as D posições da linha de u, as que sobram no vértice sentinela n
+inline const std::vector<int>& slots(const Adjacency& adj, int u) { return adj[u]; }
+
+template <int D>
+inline const std::array<int, D>& slots(const FixedDegreeAdjacency<D>& adj, int u) { return adj.row(u); }
+
+/**
+ * @brief decodeLabels e reduce_weight_heuristic para L cromossomos: o rótulo e
+ * o número de dominância do vértice v na via l ficam em v * L + l. A construção
+ * gulosa segue a ordem de chaves de cada via; a redução percorre os vértices em
+ * ordem, como RepairEngine com a fila de todos os vértices, e trata todas as
+ * vias de cada vértice juntas. O sentinela n tem rótulo 1 em todas as vias, de
+ * modo que nenhuma regra o vê como 0 ou como 2. Com L == 1, 'labels' recebe a
+ * rotulação, se não for nulo.
+ */
+template <int L, class G>
+void decodeLanes(const G& graph, const std::vector< double >* const* chromosomes, unsigned count, double* fitness,
+    Labelling* labels) {
+    constexpr bool FIXED = !std::is_same<G, Adjacency>::value;
+    const int n = graph.size();
+    Labelling label(static_cast<size_t>(n + 1) * L, 0);
+    std::vector<int> dominance(static_cast<size_t>(n + 1) * L, 0);
+    std::vector<int> order(n);
+    std::fill(label.begin() + static_cast<size_t>(n) * L, label.end(), 1);
+    PROFILE_COUNT("allocations.decoder_vectors", 3);
+
+    // Construção gulosa, via a via; um vértice está dominado quando seu número de dominância é positivo
+    for(unsigned l = 0; l < count; l++){
+        const std::vector< double >& chromosome = *chromosomes[l];
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+        [&](int a, int b){
+            return chromosome[a] > chromosome[b];
+        });
+
+        Label* f = label.data() + l;
+        int* d = dominance.data() + l;
+        for(int idx = 0; idx < n; idx++){
+            const int u = order[idx] * L;
+            if(f[u] != 0 || d[u] == 1) continue;
+            if(d[u] >= 2){
+                f[u] = 1;
+                d[u]++;
+                continue;
+            }
+
+            // Com grau limitado, a linha inteira sem desvios
+            bool hasDominatedNeighbor = false;
+            for(int v : slots(graph, order[idx])){
+                hasDominatedNeighbor |= f[v * L] == 0 && d[v * L] > 0;
+                if(!FIXED && hasDominatedNeighbor) break;
+            }
+            d[u]++;
+            if(!hasDominatedNeighbor){
+                f[u] = 2;
+                for(int v : slots(graph, order[idx])) d[v * L]++;
+            } else {
+                f[u] = 1;
+            }
+        }
+    }
+
+    // Primeira regra: um 2 que não é o único 2 de nenhum vizinho com rótulo 0 passa a 1
+    for(int u = 0; u < n; u++){
+        Label* fu = label.data() + static_cast<size_t>(u) * L;
+        bool anyTwo = false;
+        for(int l = 0; l < L; l++) anyTwo |= fu[l] == 2;
+        if(!anyTwo) continue;
+
+        int privateZero[L] = {};
+        for(int v : slots(graph, u)){
+            const Label* fv = label.data() + static_cast<size_t>(v) * L;
+            const int* dv = dominance.data() + static_cast<size_t>(v) * L;
+            for(int l = 0; l < L; l++) privateZero[l] |= (fv[l] == 0) & (dv[l] == 1);
+        }
+        int demote[L];
+        bool anyDemoted = false;
+        for(int l = 0; l < L; l++){
+            demote[l] = (fu[l] == 2) & !privateZero[l];
+            anyDemoted |= demote[l] != 0;
+        }
+        if(!anyDemoted) continue;
+        for(int l = 0; l < L; l++) fu[l] -= demote[l];
+        for(int v : slots(graph, u)){
+            int* dv = dominance.data() + static_cast<size_t>(v) * L;
+            for(int l = 0; l < L; l++) dv[l] -= demote[l];
+        }
+    }
+
+    // Segunda regra: um 1 com exatamente um vizinho 2 passa a 0; ela só lê o próprio vértice
+    int weight[L] = {};
+    for(int v = 0; v < n; v++){
+        Label* fv = label.data() + static_cast<size_t>(v) * L;
+        const int* dv = dominance.data() + static_cast<size_t>(v) * L;
+        for(int l = 0; l < L; l++){
+            fv[l] -= (fv[l] == 1) & (dv[l] == 2);
+            weight[l] += fv[l];
+        }
+    }
+
+    for(unsigned l = 0; l < count; l++) fitness[l] = weight[l];
+    if(L == 1 && labels != nullptr){
+        label.resize(n);
+        *labels = std::move(label);
+    }
+}
+
+}
+
 /**
  * @brief decoder
  */
 double DecoderRoman::decode(const std::vector< double >& chromosome) const {
+    const std::vector< double >* chromosomes[1] = {&chromosome};
+    double fitness = 0.0;
+    withBoundedDegree(bounded, adj, [&](const auto& graph) {
+        decodeLanes<1>(graph, chromosomes, 1, &fitness, nullptr);
+    });
+    return fitness;
+}
+
+/**
+ * @brief Rotulação gerada pelo decoder (a mesma usada no cálculo do fitness)
+ */
+Labelling DecoderRoman::decodeLabels(const std::vector< double >& chromosome) const {
+    const std::vector< double >* chromosomes[1] = {&chromosome};
+    double fitness = 0.0;
+    Labelling labels;
+    withBoundedDegree(bounded, adj, [&](const auto& graph) {
+        decodeLanes<1>(graph, chromosomes, 1, &fitness, &labels);
+    });
+    return labels;
+}
 
+void DecoderRoman::decodeBatch(const std::vector< double >* const* chromosomes, unsigned count, double* fitness) const {
+    withBoundedDegree(bounded, adj, [&](const auto& graph) {
+        decodeLanes<BATCH>(graph, chromosomes, count, fitness, nullptr);
+    });
+}
+
+/**
+ * @brief Chaves que o decoder transforma de volta na rotulação. A ordem das
+ * chaves é montada simulando a construção gulosa de decodeLabels: os vértices
+ * com rótulo 2, os que dominam mais vértices com rótulo 0 antes, entram
+ * quando a construção lhes dá 2, e os de rótulo 1 assim que ela lhes dá 1.
+ * Um 1 entre dois 2 precisa receber seu rótulo antes que o primeiro deles o
+ * domine; senão ele fica como um 0 dominado e o segundo 2 vira 1. Por isso um
+ * 2 vizinho de um desses 1 ainda livre espera, enquanto houver outro 2 a pôr.
+ * O que a simulação não consegue pôr vem depois, na ordem de antes: 2, 1 e 0.
+ */
+std::vector< double > DecoderRoman::encode(const std::vector<int>& labels) const {
     const int n = g.getOrder();
-	std::vector<int> order(n);
+    std::vector<int> zeros(n, 0);
+    std::vector<int> twos(n, 0);
+    for(int u = 0; u < n; u++){
+        for(int v : adj[u]){
+            if(labels[v] == 0) zeros[u]++;
+            if(labels[v] == 2) twos[u]++;
+        }
+    }
+
+    std::vector<int> order(n);
     std::iota(order.begin(), order.end(), 0);
-    
-    std::sort(order.begin(), order.end(),
+    std::stable_sort(order.begin(), order.end(),
     [&](int a, int b){
-        return chromosome[a] > chromosome[b];
+        if(labels[a] != labels[b]) return labels[a] > labels[b];
+        return zeros[a] > zeros[b];
     });
-    
-    std::vector<int> f(n, 0);
-    std::vector<int> dominanceNumber(n, 0);
-    std::vector<bool> dominated(n, false);
-    
-    
-    for(int idx = 0; idx < n; idx++){
-        int u = order[idx];
 
-        if(f[u] != 0) continue;
+    // Estado da construção gulosa, como em decodeLanes
+    std::vector<int> f(n, 0);
+    std::vector<int> d(n, 0);
+    std::vector<char> visited(n, false);
+    std::vector<int> sequence;
+    sequence.reserve(n);
 
-        if(dominanceNumber[u] == 1){
-            continue;
+    // Rótulo que a construção daria a u agora
+    auto outcome = [&](int u){
+        if(d[u] == 1) return 0;
+        if(d[u] >= 2) return 1;
+        for(int v : adj[u]){
+            if(f[v] == 0 && d[v] > 0) return 1;
         }
-
-        if(dominanceNumber[u] >= 2){
-            f[u] = 1;
-            dominated[u] = true;
-            dominanceNumber[u]++;
-            continue;
+        return 2;
+    };
+    auto visit = [&](int u){
+        visited[u] = true;
+        sequence.push_back(u);
+        const int label = outcome(u);
+        if(label == 0) return;
+        d[u]++;
+        f[u] = label;
+        if(label == 2){
+            for(int v : adj[u]) d[v]++;
+        }
+    };
+    // Pôr u como 2 não deixa um 1 entre dois 2 dominado antes de ter seu rótulo
+    auto safe = [&](int u){
+        for(int v : adj[u]){
+            if(!visited[v] && labels[v] == 1 && twos[v] >= 2 && d[v] == 0) return false;
         }
+        return true;
+    };
 
-        bool hasDominatedNeighbor = false;
-        for(int v : g.getNeighbors(u)){
-            if(f[v] == 0 && dominated[v]){
-                hasDominatedNeighbor = true;
-                break;
+    std::vector<int> ones, pending;
+    for(int u : order){
+        if(labels[u] == 1) ones.push_back(u);
+        if(labels[u] == 2) pending.push_back(u);
+    }
+    bool progress = true;
+    while(progress){
+        progress = false;
+        for(int v : ones){
+            if(!visited[v] && outcome(v) == 1){
+                visit(v);
+                progress = true;
             }
         }
-        if(!hasDominatedNeighbor){
-            f[u] = 2;
-            dominated[u] = true;
-            dominanceNumber[u]++;
-
-            for(int v : g.getNeighbors(u)){
-                dominated[v] = true;
-                dominanceNumber[v]++;
+        for(int u : pending){
+            if(!visited[u] && outcome(u) == 2 && safe(u)){
+                visit(u);
+                progress = true;
             }
-        } else {
-            f[u] = 1;
-            dominated[u] = true;
-            dominanceNumber[u]++;
         }
+        // Sem 2 seguro, o primeiro que ainda recebe 2
+        if(!progress){
+            for(int u : pending){
+                if(!visited[u] && outcome(u) == 2){
+                    visit(u);
+                    progress = true;
+                    break;
+                }
+            }
+        }
+        auto done = [&](int u){ return static_cast<bool>(visited[u]); };
+        ones.erase(std::remove_if(ones.begin(), ones.end(), done), ones.end());
+        pending.erase(std::remove_if(pending.begin(), pending.end(), done), pending.end());
     }
-
-    reduce_weight_heuristic(g, f, dominanceNumber);
-
-    //  checkPRD(g, f);
-
-    double cost = 0.0;
-    for(int v = 0; v < n; v++){
-        cost += f[v];
+    for(int u : order){
+        if(!visited[u]) sequence.push_back(u);
     }
 
-    return cost;
-
+    // decodeLabels visits the keys in decreasing order
+    std::vector< double > chromosome(n);
+    for(int idx = 0; idx < n; idx++){
+        chromosome[sequence[idx]] = 1.0 - (idx + 0.5) / n;
+    }
+    return chromosome;
 }
@@ -1,26 +1,54 @@
-#ifndef DECODER_ROMAN_H
-#define DECODER_ROMAN_H
-
-#include <list>
-#include <vector>
-#include <algorithm>
-#include <random>
-#include "brkgaAPI/MTRand.h"
-#include "Graph.h"
-
-class DecoderRoman {
-public:
-    // Constructor
-	DecoderRoman(const Graph& graph) : g{graph} { }	
-
-    // Destructor
-	~DecoderRoman() = default;	        
-
-	// Decode a chromosome, returning its fitness as a double-precision floating point:
-    double decode(const std::vector< double >& chromosome) const;
-
-private:
-	const Graph& g;
-};
-
+#ifndef DECODER_ROMAN_H
+#define DECODER_ROMAN_H
+
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include "brkgaAPI/MTRand.h"
+#include "Graph.h"
+#include "../Common/Repair.hpp"
+#include "../Common/BoundedDegree.hpp"
+
+class DecoderRoman {
+public:
+    // Constructor
+	DecoderRoman(const Graph& graph);
+
+    // Destructor
+	~DecoderRoman() = default;	        
+
+	// Decode a chromosome, returning its fitness as a double-precision floating point:
+    double decode(const std::vector< double >& chromosome) const;
+
+	// Chromosomes decoded together by decodeBatch
+	static constexpr unsigned BATCH = 8;
+
+	// Decode count <= BATCH chromosomes at once, with the fitness decode would give. The
+	// lanes keep their labels and dominance numbers interleaved vertex by vertex, so the
+	// weight reduction, a pass in vertex order, handles every lane with each vertex:
+	void decodeBatch(const std::vector< double >* const* chromosomes, unsigned count, double* fitness) const;
+
+	// Decode a chromosome, returning the labelling itself:
+    Labelling decodeLabels(const std::vector< double >& chromosome) const;
+
+	// Encode a labelling as keys whose order replays the decoder's greedy construction, so
+	// that a 1 between two 2s gets its label before the second 2 comes. Labellings the decoder
+	// built decode back to themselves in practice; others, e.g. greedy ones, decode to a
+	// feasible labelling that may be heavier:
+    std::vector< double > encode(const std::vector<int>& labels) const;
+
+	// Neighbours by index, the graph the decoder reads
+	const Adjacency& adjacency() const { return adj; }
+
+private:
+	const Graph& g;
+	Adjacency adj;		// copy of the adjacency of g, without its hash lookups
+	BoundedAdjacency bounded;	// adj in rows of fixed length when its degrees are small
+};
+
+// Lowers the weight of a labelling by local relabellings, the reduce phases of
+// RepairEngine; dominanceNumber counts as in Common/Repair.hpp
+void reduce_weight_heuristic(const Adjacency& adj, Labelling& label, std::vector<int>& dominanceNumber);
+
 #endif
\ No newline at end of file
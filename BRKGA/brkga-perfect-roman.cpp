@@ -5,10 +5,27 @@
 #include <chrono>
 #include <limits>
 #include <cmath>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <sstream>
 #include "brkgaAPI/BRKGA.h"
+#include "brkgaAPI/AsyncBRKGA.h"
 #include "brkgaAPI/MTRand.h"
 #include "DecoderRoman.h"
 #include "Graph.h"
+#include "../Common/Reduction.hpp"
+#include "../Common/Reorder.hpp"
+#include "../Common/Components.hpp"
+#include "../Common/LowerBound.hpp"
+#include "../Common/KnownOptima.hpp"
+#include "../Common/TTT.hpp"
+#include "../Common/Trace.hpp"
+#include "../Common/Profile.hpp"
+#include "../Common/Batch.hpp"
+#include "../Common/Server.hpp"
+#include "../Common/Greedy.hpp"
+#include "../Common/Seed.hpp"
 
 #define DEBUG 0
 #define IRACE 0
@@ -28,7 +45,21 @@ struct AlgorithmParameters {
 	unsigned X_NUMBER = 2;	    // exchange top 2 best
 	unsigned MAX_GENS = 1000;	// maximum number of generations
 	unsigned MAX_STAGT = 400;   // number of stagnation
+	bool async = false;         // asynchronous BRKGA: one population, MAXT workers, no generations
 	unsigned trials = 1;        // number of executions of the genetic algorithm
+	bool reduce = false;        // run on the kernel given by the exact reductions
+	bool components = false;    // solve each connected component on its own
+	VertexOrder order = VertexOrder::NONE;	// relabelling of the searched graph for locality
+	unsigned threads = 1;       // number of components solved at the same time
+	std::vector<int> targets;   // stop at the first solution this good, several only for --ttt; empty for none
+	std::string known_optima;   // results CSV to take the target from
+	unsigned ttt = 0;           // runs of a time-to-target experiment; 0 for a normal run
+	std::string trace;          // convergence trace file; empty for none
+	std::string batch;          // directory or instance list of a batch run; empty for one graph
+	int workers = 0;            // threads of a batch run or server; 0 for one per hardware thread
+	std::string server;         // socket of the evaluation server, "-" for stdin; empty for none
+	std::string instances;      // directory or instance list the server preloads
+	std::string warm_start;     // "greedy", or a file of labels to start from; empty for random keys only
 };
 
 struct Result {
@@ -38,87 +69,351 @@ struct Result {
     float graph_density;
     int fitness;
     double elapsed_time;
+    int lower_bound;
+    double time_to_target = -1;
 };
 
 AlgorithmParameters parse_args(int argc, char *argv[]);
+bool parse_option(AlgorithmParameters& parameters, int argc, char *argv[], int& i);
 void ensure_csv_header(const std::string &filename);
+std::string csv_row(const Result &result);
 void write_result_to_csv(const std::string &filename, const Result &result);
 bool isFeasible(const std::vector<double>& chromosome, const Graph& graph);
+Graph buildGraph(const Adjacency& adj);
+std::vector<int> evolve(const Graph& graph, const AlgorithmParameters& parameters, unsigned threads, long unsigned seed,
+	int lowerBound, int target = -1, double* timeToTarget = nullptr, TraceSink* trace = nullptr,
+	const std::vector<int>* startLabels = nullptr);
+std::vector<int> evolveAsync(const Graph& graph, const AlgorithmParameters& parameters, unsigned threads, long unsigned seed,
+	int lowerBound, int target, double* timeToTarget, TraceSink* trace, const std::vector<int>* startLabels);
+std::vector<std::vector<double>> warmStart(const DecoderRoman& decoder, const AlgorithmParameters& parameters,
+	unsigned eliteSize, unsigned population, long unsigned seed, const std::vector<int>* startLabels);
+std::vector<int> readLabels(const std::string& path, size_t n);
+double keyDiversity(const BRKGA<DecoderRoman, MTRand>& algorithm);
+double keyDiversity(const std::vector<std::shared_ptr<const std::vector<double>>>& chromosomes);
+
+
+// Everything the trials on one graph share: the input, the exact reduction,
+// the vertex ordering, the bounds, the target and the component decomposition
+struct PreparedGraph {
+	std::string filename;
+	Graph g;
+	Adjacency adj;
+	std::unique_ptr<Reduction> reduction;
+	std::unique_ptr<VertexOrdering> ordering;
+	std::unique_ptr<ComponentDecomposition> decomposition;
+	Graph kernel;	// the kernel, relabelled by the ordering, when the search is not on g
+	int searchBound = 0;
+	std::vector<int> componentBounds;	// searchBound, component by component
+	int bound = 0;
+	int target = -1;
+	int searchTarget = -1;
+	double preprocessingTime = 0.0;
+	std::vector<int> startLabels;	// labelling of --warm-start FILE
+
+	// The graph the BRKGA searches
+	const Graph& searchGraph() const { return (reduction || ordering) ? kernel : g; }
+};
 
+std::unique_ptr<PreparedGraph> prepareGraph(const AlgorithmParameters& parameters, const std::string& filename,
+	const std::map<std::string, int>& knownOptima, bool verbose) {
+	auto prepared = std::make_unique<PreparedGraph>();
+	PreparedGraph& p = *prepared;
+	p.filename = filename;
+	p.g = Graph(filename);
+
+	// Optional exact preprocessing: the BRKGA runs on the kernel and the best
+	// labelling is lifted back to g
+	p.adj = readAdjacency(filename);
+	if (parameters.reduce) {
+		auto begin = std::chrono::high_resolution_clock::now();
+		p.reduction = std::make_unique<Reduction>(p.adj);
+		p.reduction->apply();
+		p.preprocessingTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count();
+		#if !IRACE
+		if (verbose) p.reduction->printSummary(std::cout);
+		#endif
+	}
 
-int main(int argc, char *argv[]) {
-    
-	AlgorithmParameters parameters = parse_args(argc, argv);
-
-	ensure_csv_header(parameters.output_file);
+	// Optional relabelling of the graph the BRKGA searches, for locality; its
+	// labellings are mapped back before the lift
+	if (parameters.order != VertexOrder::NONE) {
+		auto begin = std::chrono::high_resolution_clock::now();
+		p.ordering = std::make_unique<VertexOrdering>(parameters.reduce ? p.reduction->kernel() : p.adj, parameters.order);
+		p.preprocessingTime += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count();
+		#if !IRACE
+		if (verbose) std::cout << "Vertex order " << vertexOrderName(parameters.order) << ": bandwidth "
+			<< p.ordering->originalBandwidth() << " -> " << p.ordering->bandwidth() << std::endl;
+		#endif
+	}
+	const Adjacency& search = p.ordering ? p.ordering->graph() : parameters.reduce ? p.reduction->kernel() : p.adj;
+
+	// Lower bound on the graph the BRKGA searches: a run that reaches it is optimal.
+	// Its cost is capped by the exact-time budget of lowerBound, and is not
+	// part of the run time.
+	p.componentBounds = componentLowerBounds(search);
+	p.searchBound = std::accumulate(p.componentBounds.begin(), p.componentBounds.end(), 0);
+	p.bound = p.searchBound + (parameters.reduce ? p.reduction->fixedWeight() : 0);
+
+	// Optional target weight: the run stops at the first solution that reaches it
+	p.target = targetFor(filename, parameters.targets.empty() ? -1 : parameters.targets.front(), knownOptima);
+	p.searchTarget = (p.target >= 0 && parameters.reduce) ? std::max(p.target - p.reduction->fixedWeight(), -1) : p.target;
+	if (parameters.reduce || p.ordering) p.kernel = buildGraph(search);
+
+	// Component mode runs one BRKGA per connected component
+	if (parameters.components) {
+		p.decomposition = std::make_unique<ComponentDecomposition>(search);
+	}
 
-	std::string filename(parameters.file_path);
+	// A warm-start labelling is one of the input graph, which is only the
+	// graph the BRKGA searches, up to the ordering, without reduction and
+	// components
+	if (!parameters.warm_start.empty() && parameters.warm_start != "greedy") {
+		if (parameters.reduce || parameters.components) {
+			throw std::runtime_error("--warm-start FILE cannot be combined with --reduce or --components");
+		}
+		p.startLabels = readLabels(parameters.warm_start, p.g.getOrder());
+		if (p.ordering) p.startLabels = p.ordering->apply(p.startLabels);
+	}
+	return prepared;
+}
 
+// One run of the whole pipeline; the decoder only reads the graph, so runs on
+// the same prepared graph can go in parallel
+Result runTrial(const AlgorithmParameters& parameters, const PreparedGraph& p, long unsigned seed, unsigned threads,
+	int run, const std::string& tracePath, bool verbose) {
+	Result result;
+	result.graph_name = std::filesystem::path(p.filename).filename().string();
+	result.node_count = p.g.getOrder();
+	result.edge_count = p.g.getSize();
+	result.graph_density = p.g.getDensity();
+	result.lower_bound = p.bound;
+
+	// Everything was fixed by the reduction
+	if (p.searchGraph().getOrder() == 0) {
+		result.fitness = p.reduction->fixedWeight();
+		result.elapsed_time = p.preprocessingTime;
+		if (p.target >= 0 && result.fitness <= p.target) {
+			result.time_to_target = p.preprocessingTime;
+		}
+		return result;
+	}
 
-	Graph g(filename);
+	auto begin = std::chrono::high_resolution_clock::now();
+
+	std::vector<int> labels;
+	if (p.decomposition) {
+		ComponentStats stats;
+		labels = solveByComponents(*p.decomposition, [&](const Adjacency& component, int index) {
+			// Independent stream per component, so the result does not depend on the schedule
+			return evolve(buildGraph(component), parameters, 1, seed * p.decomposition->size() + index, p.componentBounds[index]);
+		}, threads, &stats);
+		#if !IRACE
+		if (verbose) stats.print(std::cout);
+		#endif
+	} else {
+		std::unique_ptr<TraceSink> trace;
+		if (!tracePath.empty()) {
+			trace = std::make_unique<TraceSink>(tracePath, run, parameters.reduce ? p.reduction->fixedWeight() : 0);
+		}
+		labels = evolve(p.searchGraph(), parameters, threads, seed, p.searchBound, p.searchTarget, &result.time_to_target, trace.get(),
+			p.startLabels.empty() ? nullptr : &p.startLabels);
+		if (result.time_to_target >= 0) {
+			result.time_to_target += p.preprocessingTime;
+		}
+	}
 
-	parameters.n = g.getOrder();
+	if (p.ordering) {
+		labels = p.ordering->restore(labels);
+	}
+	if (parameters.reduce) {
+		labels = p.reduction->lift(labels);
+	}
+	if (parameters.reduce || parameters.components || p.ordering) {
+		if (!isPerfectRoman(p.adj, labels)) {
+			throw std::runtime_error("Final solution is not a perfect Roman dominating function: " + p.filename);
+		}
+	}
 
-	for (size_t trial = 0; trial < parameters.trials; ++trial) {
-		#if DEBUG
-        std::cout << "------------------------------------------------------------\n";
-        std::cout << "Running trial " << (trial+1) << " of " << parameters.trials << "\n";
-        #endif
+	auto end = std::chrono::high_resolution_clock::now();
+	//auto elapsed_time = std::chrono::duration_cast<std::chrono::seconds>(end-begin);
+	auto elapsed_time = std::chrono::duration<double>(end-begin);
 
-		// initialize the decoder
-		DecoderRoman decoder(g);
+	result.fitness = labelWeight(labels);
+	result.elapsed_time = elapsed_time.count() + p.preprocessingTime;
 
-		const long unsigned rngSeed = trial;	// seed to the random number generator
-		MTRand rng((rngSeed + 1) * 1234);	    // initialize the random number generator
+	// Component runs reach the target only at the end
+	if (p.target >= 0 && result.fitness <= p.target && result.time_to_target < 0) {
+		result.time_to_target = result.elapsed_time;
+	}
+	return result;
+}
 
-        unsigned pop_size = parameters.n / parameters.population_factor;
-        
-		// initialize the BRKGA-based heuristic
-		BRKGA<DecoderRoman, MTRand> algorithm(parameters.n, pop_size, parameters.pe, 
-			parameters.pm, parameters.rhoe, decoder, rng, parameters.K, parameters.MAXT);
+// Batch mode: every trial of every graph of parameters.batch in one process.
+// The jobs decode on one thread each and run on parameters.workers threads.
+void runBatchBRKGA(const AlgorithmParameters& parameters) {
+	if (parameters.ttt > 0) {
+		throw std::runtime_error("--ttt and --batch cannot be combined");
+	}
 
-		#if DEBUG
-        std::cout << "Population size = " << pop_size << std::endl;
-		std::cout << "Running for " << parameters.MAX_GENS << " generations..." << std::endl;
-		#endif
+	std::map<std::string, int> knownOptima;
+	if (!parameters.known_optima.empty()) {
+		knownOptima = readKnownOptima(parameters.known_optima);
+	}
+	const std::vector<std::string> paths = batchInstances(parameters.batch);
+	BatchWriter writer(parameters.output_file);
+
+	// The jobs overlap, so the profile covers all of them (run -1)
+	PROFILE_RESET();
+	runBatch<PreparedGraph>(paths, parameters.trials, parameters.workers, parameters.MAX_GENS,
+		[&](const std::string& path) { return prepareGraph(parameters, path, knownOptima, false); },
+		[&](const PreparedGraph& prepared, const std::string& path, int trial) {
+			const std::string tracePath = parameters.trace.empty() ? ""
+				: tttPath(parameters.trace, "_" + std::filesystem::path(path).stem().string() + "_" + std::to_string(trial));
+			writer.write(csv_row(runTrial(parameters, prepared, trial, 1, trial, tracePath, false)));
+		});
+	PROFILE_REPORT(std::filesystem::path(parameters.output_file).replace_extension().string() + "_profile.json",
+		"batch", "BRKGA", -1);
+}
 
-		auto begin = std::chrono::high_resolution_clock::now();
-		
-		unsigned generation = 0;		// current generation
-		unsigned stagnant_count = 0;
+// Server mode: answers evaluation requests for irace (see Common/Server.hpp)
+// on parameters.server, a socket path or "-" for stdin. The graphs of
+// parameters.instances are prepared at start-up, any other graph at its
+// first request. Each evaluation decodes on one core, whatever its MAXT:
+// the decoded values, and so the results, do not depend on it.
+void runServerBRKGA(const AlgorithmParameters& parameters) {
+	std::map<std::string, int> knownOptima;
+	if (!parameters.known_optima.empty()) {
+		knownOptima = readKnownOptima(parameters.known_optima);
+	}
 
-		double bestFitness = std::numeric_limits<double>::max();
-		
-		do {
-			algorithm.evolve();	// evolve the population for one generation
-			
-			if(bestFitness > algorithm.getBestFitness()) {
-				bestFitness = algorithm.getBestFitness();
-				stagnant_count = 0;
-				#if DEBUG
-				std::cout << "generation " << generation << ", new best fitness: " << bestFitness << "\n";
-				#endif
-			} else {
-				stagnant_count++;
+	// A prepared graph depends on the preprocessing options as well
+	auto cacheKey = [](const AlgorithmParameters& p, const std::string& path) {
+		return std::filesystem::weakly_canonical(path).string() + (p.reduce ? " reduce" : "")
+			+ (p.components ? " components" : "") + " " + vertexOrderName(p.order) + " " + std::to_string(p.targets.empty() ? -1 : p.targets.front());
+	};
+	std::mutex cacheMutex;
+	std::map<std::string, std::shared_ptr<const PreparedGraph>> cache;
+	if (!parameters.instances.empty()) {
+		for (const std::string& path : batchInstances(parameters.instances)) {
+			try {
+				cache[cacheKey(parameters, path)] = prepareGraph(parameters, path, knownOptima, false);
+			} catch (const std::exception& e) {
+				std::cerr << "Skipping " << path << ": " << e.what() << std::endl;
 			}
-			
-			if((++generation) % parameters.X_INTVL == 0) {
-				algorithm.exchangeElite(parameters.X_NUMBER);	// exchange top individuals
+		}
+	}
+	std::cerr << "Serving " << cache.size() << " preloaded instances on " << parameters.server << std::endl;
+
+	RequestHandler handler = [&](const std::vector<std::string>& words) {
+		AlgorithmParameters request = parameters;
+		const long unsigned seed = std::stoul(words[0]);
+		std::vector<std::string> options(words.begin() + 2, words.end());
+		std::vector<char*> argv;
+		for (std::string& option : options) argv.push_back(option.data());
+		for (int i = 0; i < static_cast<int>(argv.size()); i++) {
+			if (!parse_option(request, argv.size(), argv.data(), i)) {
+				throw std::runtime_error("unknown argument " + options[i]);
 			}
-		} while (generation < parameters.MAX_GENS && stagnant_count < parameters.MAX_STAGT);
+		}
+
+		const std::string key = cacheKey(request, words[1]);
+		std::shared_ptr<const PreparedGraph> prepared;
+		{
+			std::lock_guard<std::mutex> lock(cacheMutex);
+			auto it = cache.find(key);
+			if (it != cache.end()) prepared = it->second;
+		}
+		if (!prepared) {
+			prepared = prepareGraph(request, words[1], knownOptima, false);
+			std::lock_guard<std::mutex> lock(cacheMutex);
+			cache.emplace(key, prepared);
+		}
+
+		Result result = runTrial(request, *prepared, seed, 1, 0, "", false);
+		std::ostringstream response;
+		response << result.fitness << " " << result.elapsed_time;
+		return response.str();
+	};
+
+	if (parameters.server == "-") {
+		serveStream(std::cin, std::cout, parameters.workers, handler);
+	} else {
+		serveSocket(parameters.server, parameters.workers, handler);
+	}
+}
 
-		auto end = std::chrono::high_resolution_clock::now();
-    	//auto elapsed_time = std::chrono::duration_cast<std::chrono::seconds>(end-begin);
-        auto elapsed_time = std::chrono::duration<double>(end-begin);
+int main(int argc, char *argv[]) {
+    
+	AlgorithmParameters parameters = parse_args(argc, argv);
+
+	if (!parameters.server.empty()) {
+		runServerBRKGA(parameters);
+		return 0;
+	}
+
+	if (parameters.ttt == 0) ensure_csv_header(parameters.output_file);
+
+	if (!parameters.batch.empty()) {
+		runBatchBRKGA(parameters);
+		return 0;
+	}
+
+	std::string filename(parameters.file_path);
+
+	std::map<std::string, int> knownOptima;
+	if (!parameters.known_optima.empty()) {
+		knownOptima = readKnownOptima(parameters.known_optima);
+	}
+	std::unique_ptr<PreparedGraph> prepared = prepareGraph(parameters, filename, knownOptima, true);
+	parameters.n = prepared->searchGraph().getOrder();
+
+	std::filesystem::path input_path(parameters.file_path);
+
+	// TTT mode: many independent runs, spread over the threads, each stopping at
+	// the target. Every target gets an experiment of its own, on the same seeds.
+	const std::vector<int> targets = parameters.targets.empty() ? std::vector<int>{-1} : parameters.targets;
+	for (size_t t = 0; t < targets.size() && parameters.ttt > 0; t++) {
+		prepared->target = targetFor(filename, targets[t], knownOptima);
+		prepared->searchTarget = (prepared->target >= 0 && parameters.reduce)
+			? std::max(prepared->target - prepared->reduction->fixedWeight(), -1) : prepared->target;
+		if (prepared->target < 0) {
+			throw std::runtime_error("--ttt needs a target (--target or --known-optima): " + filename);
+		}
+		PROFILE_RESET();
+		std::vector<TTTRun> runs = runTTT(parameters.ttt, 0, parameters.threads, [&](int index, unsigned long seed) {
+			// The runs go in parallel, so each one traces to its own file
+			const std::string suffix = targets.size() > 1 ? "_" + std::to_string(prepared->target) + "_" + std::to_string(index)
+				: "_" + std::to_string(index);
+			const std::string tracePath = parameters.trace.empty() ? "" : tttPath(parameters.trace, suffix);
+			Result result = runTrial(parameters, *prepared, seed, 1, index, tracePath, false);
+			TTTRun run;
+			run.fitness = result.fitness;
+			run.elapsed_time = result.elapsed_time;
+			run.time_to_target = result.time_to_target;
+			return run;
+		});
+
+		const std::string graphName = input_path.stem().string();
+		writeTTTRuns(tttPath(parameters.output_file, "_ttt"), graphName, "BRKGA", prepared->target, runs);
+		writeTTTPlot(tttPath(parameters.output_file, "_ttt_plot"), graphName, "BRKGA", prepared->target, runs);
+		// The runs overlap, so the profile covers all of them (run -1)
+		PROFILE_REPORT(std::filesystem::path(parameters.output_file).replace_extension().string() + "_profile.json", graphName, "BRKGA", -1);
+		#if !IRACE
+		printTTTSummary(std::cout, prepared->target, runs);
+		#endif
+	}
+
+	for (size_t trial = 0; trial < parameters.trials && parameters.ttt == 0; ++trial) {
+		#if DEBUG
+        std::cout << "------------------------------------------------------------\n";
+        std::cout << "Running trial " << (trial+1) << " of " << parameters.trials << "\n";
+        #endif
 
-		std::filesystem::path input_path(parameters.file_path);
-		Result result;
-		result.graph_name = input_path.filename().string();
-		result.node_count = g.getOrder();
-		result.edge_count = g.getSize();
-		result.fitness = algorithm.getBestFitness();
-		result.elapsed_time = elapsed_time.count();
-		result.graph_density = g.getDensity();
+		PROFILE_RESET();
+		Result result = runTrial(parameters, *prepared, trial, prepared->decomposition ? parameters.threads : parameters.MAXT,
+			trial, parameters.trace, trial == 0);
+		PROFILE_REPORT(std::filesystem::path(parameters.output_file).replace_extension().string() + "_profile.json",
+			input_path.stem().string(), "BRKGA", trial);
 
 		#if DEBUG
         std::cout << "\nResult of the trial " << trial << ":\n";
@@ -133,7 +428,7 @@ int main(int argc, char *argv[]) {
         #endif
 
 		#if IRACE
-		std::cout << algorithm.getBestFitness();
+		std::cout << result.fitness;
 		#endif
 
         #if !IRACE
@@ -149,11 +444,74 @@ int main(int argc, char *argv[]) {
 }
 
 
+// Reads the option at argv[i] and its value, leaving i on the last word
+// read; false if the option is unknown
+bool parse_option(AlgorithmParameters& parameters, int argc, char *argv[], int& i) {
+    std::string arg = argv[i];
+    if (arg == "--population_factor" && i + 1 < argc) {
+        parameters.population_factor = std::stoul(argv[++i]);
+    } else if (arg == "--pe" && i + 1 < argc) {
+        parameters.pe = std::stod(argv[++i]);
+    } else if (arg == "--pm" && i + 1 < argc) {
+        parameters.pm = std::stod(argv[++i]);
+    } else if (arg == "--rhoe" && i + 1 < argc) {
+        parameters.rhoe = std::stod(argv[++i]);
+    } else if (arg == "--K" && i + 1 < argc) {
+        parameters.K = std::stoul(argv[++i]);
+    } else if (arg == "--MAXT" && i + 1 < argc) {
+        parameters.MAXT = std::stoul(argv[++i]);
+    } else if (arg == "--X_INTVL" && i + 1 < argc) {
+        parameters.X_INTVL = std::stoul(argv[++i]);
+    } else if (arg == "--X_NUMBER" && i + 1 < argc) {
+        parameters.X_NUMBER = std::stoul(argv[++i]);
+    } else if (arg == "--MAX_GENS" && i + 1 < argc) {
+        parameters.MAX_GENS = std::stoul(argv[++i]);
+    } else if (arg == "--MAX_STAGT" && i + 1 < argc) {
+        parameters.MAX_STAGT = std::stoul(argv[++i]);
+    } else if (arg == "--async") {
+        parameters.async = true;
+    } else if (arg == "--trials" && i + 1 < argc) {
+        parameters.trials = std::stoul(argv[++i]);
+    } else if (arg == "--reduce") {
+        parameters.reduce = true;
+    } else if (arg == "--components") {
+        parameters.components = true;
+    } else if (arg == "--order" && i + 1 < argc) {
+        parameters.order = parseVertexOrder(argv[++i]);
+    } else if (arg == "--threads" && i + 1 < argc) {
+        parameters.threads = std::stoul(argv[++i]);
+    } else if (arg == "--target" && i + 1 < argc) {
+        parameters.targets = parseTargets(argv[++i]);
+    } else if (arg == "--known-optima" && i + 1 < argc) {
+        parameters.known_optima = argv[++i];
+    } else if (arg == "--ttt" && i + 1 < argc) {
+        parameters.ttt = std::stoul(argv[++i]);
+    } else if (arg == "--trace" && i + 1 < argc) {
+        parameters.trace = argv[++i];
+    } else if (arg == "--workers" && i + 1 < argc) {
+        parameters.workers = std::stoi(argv[++i]);
+    } else if (arg == "--instances" && i + 1 < argc) {
+        parameters.instances = argv[++i];
+    } else if (arg == "--warm-start" && i + 1 < argc) {
+        parameters.warm_start = argv[++i];
+    }
+    else if (arg == "--input" && i + 1 < argc){
+        parameters.file_path = argv[++i];
+    }else if (arg == "--output" && i + 1 < argc) {
+        parameters.output_file = argv[++i];
+    } else {
+        return false;
+    }
+    return true;
+}
+
 AlgorithmParameters parse_args(int argc, char *argv[]) {
     AlgorithmParameters parameters;
 
     if (argc < 2) {
         std::cerr << "Usage: " << argv[0] << " <graph_file> [options]\n"
+                  << "       " << argv[0] << " --batch <directory|instance_list> [options]\n"
+                  << "       " << argv[0] << " --server <socket|-> [--instances <directory|instance_list>] [options]\n"
                   << "Options:\n"
                   << "  --population_factor VALUE\n"
                   << "  --pe VALUE\n"
@@ -165,6 +523,17 @@ AlgorithmParameters parse_args(int argc, char *argv[]) {
 				  << "  --X_NUMBER VALUE\n"
 				  << "  --MAX_GENS VALUE\n"
 				  << "  --MAX_STAGT VALUE\n"
+				  << "  --async\n"
+				  << "  --reduce\n"
+				  << "  --components\n"
+				  << "  --order none|rcm|degree|bfs\n"
+				  << "  --threads VALUE\n"
+				  << "  --target VALUE[,VALUE...]\n"
+				  << "  --known-optima FILE\n"
+				  << "  --ttt RUNS\n"
+				  << "  --trace FILE\n"
+				  << "  --workers VALUE\n"
+				  << "  --warm-start greedy|FILE\n"
     
                   << "  --trials VALUE\n"
                   << "  --output FILE\n";
@@ -172,39 +541,20 @@ AlgorithmParameters parse_args(int argc, char *argv[]) {
       }
 
     #if !IRACE
-    parameters.file_path = argv[1];
-
-    for (int i{2}; i < argc; i++) {
-        std::string arg = argv[i];
-        if (arg == "--population_factor" && i + 1 < argc) {
-            parameters.population_factor = std::stoul(argv[++i]);
-        } else if (arg == "--pe" && i + 1 < argc) {
-            parameters.pe = std::stod(argv[++i]);
-        } else if (arg == "--pm" && i + 1 < argc) {
-            parameters.pm = std::stod(argv[++i]);
-        } else if (arg == "--rhoe" && i + 1 < argc) {
-            parameters.rhoe = std::stod(argv[++i]);
-        } else if (arg == "--K" && i + 1 < argc) {
-            parameters.K = std::stoul(argv[++i]);
-        } else if (arg == "--MAXT" && i + 1 < argc) {
-            parameters.MAXT = std::stoul(argv[++i]);
-        } else if (arg == "--X_INTVL" && i + 1 < argc) {
-            parameters.X_INTVL = std::stoul(argv[++i]);
-        } else if (arg == "--X_NUMBER" && i + 1 < argc) {
-            parameters.X_NUMBER = std::stoul(argv[++i]);
-        } else if (arg == "--MAX_GENS" && i + 1 < argc) {
-            parameters.MAX_GENS = std::stoul(argv[++i]);
-        } else if (arg == "--MAX_STAGT" && i + 1 < argc) {
-            parameters.MAX_STAGT = std::stoul(argv[++i]);
-        } else if (arg == "--trials" && i + 1 < argc) {
-            parameters.trials = std::stoul(argv[++i]);
-        }
-        else if (arg == "--input" && i + 1 < argc){
-            parameters.file_path = argv[++i];
-        }else if (arg == "--output" && i + 1 < argc) {
-            parameters.output_file = argv[++i];
-        } else {
-            std::cerr << "Unknown argument: " << arg << std::endl;
+    int first = 2;
+    if (std::string(argv[1]) == "--batch" && argc > 2) {
+        parameters.batch = argv[2];
+        first = 3;
+    } else if (std::string(argv[1]) == "--server" && argc > 2) {
+        parameters.server = argv[2];
+        first = 3;
+    } else {
+        parameters.file_path = argv[1];
+    }
+
+    for (int i{first}; i < argc; i++) {
+        if (!parse_option(parameters, argc, argv, i)) {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
             exit(1);
         }
     }
@@ -212,44 +562,22 @@ AlgorithmParameters parse_args(int argc, char *argv[]) {
     #endif
 
     #if IRACE
-    parameters.file_path = argv[4];         
+    parameters.file_path = argv[4];
 
     for (int i{5}; i < argc; i++) {
-        std::string arg = argv[i];
-        if (arg == "--population_factor" && i + 1 < argc) {
-            parameters.population_factor = std::stoul(argv[++i]);
-        } else if (arg == "--pe" && i + 1 < argc) {
-            parameters.pe = std::stod(argv[++i]);
-        } else if (arg == "--pm" && i + 1 < argc) {
-            parameters.pm = std::stod(argv[++i]);
-        } else if (arg == "--rhoe" && i + 1 < argc) {
-            parameters.rhoe = std::stod(argv[++i]);
-        } else if (arg == "--K" && i + 1 < argc) {
-            parameters.K = std::stoul(argv[++i]);
-        } else if (arg == "--MAXT" && i + 1 < argc) {
-            parameters.MAXT = std::stoul(argv[++i]);
-        } else if (arg == "--X_INTVL" && i + 1 < argc) {
-            parameters.X_INTVL = std::stoul(argv[++i]);
-        } else if (arg == "--X_NUMBER" && i + 1 < argc) {
-            parameters.X_NUMBER = std::stoul(argv[++i]);
-        } else if (arg == "--MAX_GENS" && i + 1 < argc) {
-            parameters.MAX_GENS = std::stoul(argv[++i]);
-        } else if (arg == "--MAX_STAGT" && i + 1 < argc) {
-            parameters.MAX_STAGT = std::stoul(argv[++i]);
-        } else if (arg == "--trials" && i + 1 < argc) {
-            parameters.trials = std::stoul(argv[++i]);
-        }
-        else if (arg == "--input" && i + 1 < argc){
-            parameters.file_path = argv[++i];
-        }else if (arg == "--output" && i + 1 < argc) {
-            parameters.output_file = argv[++i];
-        } else {
-            std::cerr << "Unknown argument: " << arg << std::endl;
+        if (!parse_option(parameters, argc, argv, i)) {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
             exit(1);
         }
     }
     #endif
 
+    // A normal run stops at one target
+    if (parameters.targets.size() > 1 && parameters.ttt == 0) {
+        std::cerr << "Several targets need --ttt" << std::endl;
+        exit(1);
+    }
+
     return parameters;
 }
 
@@ -258,15 +586,243 @@ void ensure_csv_header(const std::string &filename) {
     std::ofstream file;
     if (!file_exists) {
         file.open(filename);
-        file << "graph_name,graph_order,graph_size,density,fitness_value,elapsed_time(seconds)\n";
+        file << "graph_name,graph_order,graph_size,density,fitness_value,elapsed_time(seconds),lower_bound,gap,time_to_target\n";
         file.close();
     } 
 }
 
+std::string csv_row(const Result &result) {
+    std::ostringstream row;
+    row << result.graph_name << "," << result.node_count << ","
+        << result.edge_count << "," << result.graph_density << "," << result.fitness << ","
+        << result.elapsed_time << "," << result.lower_bound << ","
+        << relativeGap(result.fitness, result.lower_bound) << "," << result.time_to_target << "\n";
+    return row.str();
+}
+
 void write_result_to_csv(const std::string &filename, const Result &result) {
     std::ofstream file(filename, std::ios::app);
-    file << result.graph_name << "," << result.node_count << ","
-         << result.edge_count << "," << result.graph_density << "," << result.fitness << ","
-         << result.elapsed_time << "\n"; 
+    file << csv_row(result);
     file.close();
 }
+
+Graph buildGraph(const Adjacency& adj) {
+    Graph graph;
+    for (size_t u = 0; u < adj.size(); u++) graph.addVertex(u);
+    for (size_t u = 0; u < adj.size(); u++) {
+        for (int v : adj[u]) {
+            if (u < static_cast<size_t>(v)) graph.addEdge(u, v);
+        }
+    }
+    return graph;
+}
+
+std::vector<int> evolve(const Graph& graph, const AlgorithmParameters& parameters, unsigned threads, long unsigned seed,
+	int lowerBound, int target, double* timeToTarget, TraceSink* trace, const std::vector<int>* startLabels) {
+	if (parameters.async) {
+		return evolveAsync(graph, parameters, threads, seed, lowerBound, target, timeToTarget, trace, startLabels);
+	}
+	const unsigned n = graph.getOrder();
+
+	// initialize the decoder
+	DecoderRoman decoder(graph);
+
+	MTRand rng((seed + 1) * 1234);	    // initialize the random number generator
+
+	unsigned pop_size = n / parameters.population_factor;
+	// The elite set needs at least one chromosome
+	pop_size = std::max(pop_size, static_cast<unsigned>(std::ceil(1.0 / parameters.pe)) + 1);
+
+	// initialize the BRKGA-based heuristic
+	BRKGA<DecoderRoman, MTRand> algorithm(n, pop_size, parameters.pe,
+		parameters.pm, parameters.rhoe, decoder, rng, parameters.K, threads);
+
+	for (unsigned j = 0; j < parameters.K; j++) {
+		for (const std::vector<double>& chromosome : warmStart(decoder, parameters, algorithm.getPe(), j, seed, startLabels)) {
+			algorithm.injectChromosome(chromosome, j);
+		}
+	}
+
+	#if DEBUG
+	std::cout << "Population size = " << pop_size << std::endl;
+	std::cout << "Running for " << parameters.MAX_GENS << " generations..." << std::endl;
+	#endif
+
+	unsigned generation = 0;		// current generation
+	unsigned stagnant_count = 0;
+
+	double bestFitness = std::numeric_limits<double>::max();
+	const auto begin = std::chrono::high_resolution_clock::now();
+	if (trace) trace->restart();
+
+	// On a batch worker the K populations of a generation are evolved as
+	// separate tasks, which idle workers can take; each population then
+	// draws from its own generator, seeded from rng
+	const bool split = onPoolWorker() && parameters.K > 1;
+	std::vector<MTRand> populationRngs;
+	if (split) {
+		for (unsigned j = 0; j < parameters.K; j++) populationRngs.emplace_back(rng.randInt());
+	}
+
+	do {
+		if (split) {
+			forkJoin(parameters.K, [&](int j) { algorithm.evolvePopulation(j, populationRngs[j]); });
+		} else {
+			algorithm.evolve();	// evolve the population for one generation
+		}
+
+		if(bestFitness > algorithm.getBestFitness()) {
+			bestFitness = algorithm.getBestFitness();
+			stagnant_count = 0;
+			if (trace) trace->record(generation + 1, static_cast<int>(bestFitness), keyDiversity(algorithm));
+			#if DEBUG
+			std::cout << "generation " << generation << ", new best fitness: " << bestFitness << "\n";
+			#endif
+		} else {
+			stagnant_count++;
+		}
+
+		if (target >= 0 && bestFitness <= target) {
+			if (timeToTarget) {
+				*timeToTarget = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count();
+			}
+			break;
+		}
+
+		if((++generation) % parameters.X_INTVL == 0) {
+			algorithm.exchangeElite(parameters.X_NUMBER);	// exchange top individuals
+		}
+	} while (generation < parameters.MAX_GENS && stagnant_count < parameters.MAX_STAGT && bestFitness > lowerBound);
+
+	return toInts(decoder.decodeLabels(algorithm.getBestChromosome()));
+}
+
+// evolve with AsyncBRKGA: one population of the same size, decoded by
+// 'threads' workers. Its budgets are those of evolve in evaluations, a
+// generation of the K populations being K (p - pe) offspring; X_INTVL and
+// X_NUMBER have no populations to exchange between.
+std::vector<int> evolveAsync(const Graph& graph, const AlgorithmParameters& parameters, unsigned threads, long unsigned seed,
+	int lowerBound, int target, double* timeToTarget, TraceSink* trace, const std::vector<int>* startLabels) {
+	const unsigned n = graph.getOrder();
+	DecoderRoman decoder(graph);
+	MTRand rng((seed + 1) * 1234);
+
+	unsigned pop_size = n / parameters.population_factor;
+	pop_size = std::max(pop_size, static_cast<unsigned>(std::ceil(1.0 / parameters.pe)) + 1);
+
+	AsyncBRKGA<DecoderRoman, MTRand> algorithm(n, pop_size, parameters.pe,
+		parameters.pm, parameters.rhoe, decoder, rng, std::max(threads, 1u));
+	for (const std::vector<double>& chromosome : warmStart(decoder, parameters, algorithm.getPe(), 0, seed, startLabels)) {
+		algorithm.injectChromosome(chromosome);
+	}
+
+	const unsigned long generation = static_cast<unsigned long>(parameters.K) * (algorithm.getP() - algorithm.getPe());
+	const auto begin = std::chrono::high_resolution_clock::now();
+	if (trace) trace->restart();
+
+	// The first population counts as generation 0
+	double bestFitness = algorithm.getBestFitness();
+	if (trace) trace->record(0, static_cast<int>(bestFitness), keyDiversity(algorithm.snapshot()));
+	auto reached = [&](double fitness) {
+		if (target >= 0 && fitness <= target) {
+			if (timeToTarget) {
+				*timeToTarget = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count();
+			}
+			return true;
+		}
+		return fitness <= lowerBound;
+	};
+
+	if (!reached(bestFitness)) {
+		algorithm.evolve(parameters.MAX_GENS * generation, parameters.MAX_STAGT * generation,
+			[&](double fitness, unsigned long evaluation) {
+				if (trace) trace->record(static_cast<int>(evaluation / generation) + 1, static_cast<int>(fitness), keyDiversity(algorithm.snapshot()));
+				#if DEBUG
+				std::cout << "evaluation " << evaluation << ", new best fitness: " << fitness << "\n";
+				#endif
+				return reached(fitness);
+			});
+	}
+
+	return toInts(decoder.decodeLabels(algorithm.getBestChromosome()));
+}
+
+// Warm start: encoded labellings that evolve injects into 'population' in
+// place of its worst random chromosomes. With "greedy", each population gets
+// the greedy labelling and GRASP variants of it, half as many as its elite
+// set; they draw from their own streams, so rng is left as without them.
+std::vector<std::vector<double>> warmStart(const DecoderRoman& decoder, const AlgorithmParameters& parameters,
+	unsigned eliteSize, unsigned population, long unsigned seed, const std::vector<int>* startLabels) {
+	std::vector<std::vector<double>> chromosomes;
+	if (parameters.warm_start == "greedy") {
+		const Adjacency& adj = decoder.adjacency();
+		const unsigned count = std::max(1u, eliteSize / 2);
+		for (unsigned k = 0; k < count; k++) {
+			std::mt19937 random(SeedSequence(seed).child(population * count + k).seed());
+			chromosomes.push_back(decoder.encode(greedyPerfectRoman(adj, k == 0 ? 0.0 : 0.3, &random)));
+		}
+	} else if (startLabels != nullptr) {
+		chromosomes.push_back(decoder.encode(*startLabels));
+		// The keys may decode to a heavier labelling than the file holds
+		const int weight = std::accumulate(startLabels->begin(), startLabels->end(), 0);
+		const int decoded = decoder.decode(chromosomes.back());
+		if (population == 0 && decoded > weight) {
+			std::cerr << "Warning: the --warm-start labelling of weight " << weight
+				<< " decodes to weight " << decoded << std::endl;
+		}
+	}
+	return chromosomes;
+}
+
+// Labels of a --warm-start file: one of 0, 1 or 2 per vertex, in vertex order
+std::vector<int> readLabels(const std::string& path, size_t n) {
+	std::ifstream file(path);
+	if (!file.is_open()) {
+		throw std::runtime_error("Error opening file: " + path);
+	}
+	std::vector<int> labels;
+	int label;
+	while (file >> label) {
+		if (label < 0 || label > 2) {
+			throw std::runtime_error("Invalid label " + std::to_string(label) + " in " + path);
+		}
+		labels.push_back(label);
+	}
+	if (labels.size() != n) {
+		throw std::runtime_error(path + " has " + std::to_string(labels.size()) + " labels for "
+			+ std::to_string(n) + " vertices");
+	}
+	return labels;
+}
+
+// Mean distance between the keys of a chromosome and those of the best one,
+// over every population; about 1/3 for random keys and 0 once converged
+double keyDiversity(const BRKGA<DecoderRoman, MTRand>& algorithm) {
+	const std::vector<double>& best = algorithm.getBestChromosome();
+	double total = 0.0;
+	unsigned long count = 0;
+	for (unsigned k = 0; k < algorithm.getK(); ++k) {
+		const Population& population = algorithm.getPopulation(k);
+		for (unsigned i = 0; i < population.getP(); ++i) {
+			const std::vector<double>& chromosome = population.getChromosome(i);
+			for (unsigned j = 0; j < best.size(); ++j) {
+				total += std::fabs(chromosome[j] - best[j]);
+			}
+			count += best.size();
+		}
+	}
+	return count == 0 ? 0.0 : total / count;
+}
+
+// Same over the chromosomes of AsyncBRKGA::snapshot, the first one the best
+double keyDiversity(const std::vector<std::shared_ptr<const std::vector<double>>>& chromosomes) {
+	if (chromosomes.empty()) return 0.0;
+	const std::vector<double>& best = *chromosomes.front();
+	double total = 0.0;
+	for (const std::shared_ptr<const std::vector<double>>& chromosome : chromosomes) {
+		for (unsigned j = 0; j < best.size(); ++j) {
+			total += std::fabs((*chromosome)[j] - best[j]);
+		}
+	}
+	return total / (static_cast<double>(chromosomes.size()) * best.size());
+}
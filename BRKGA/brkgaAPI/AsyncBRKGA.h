@@ -0,0 +1,370 @@
+/**
+ * AsyncBRKGA.h
+ *
+ * Asynchronous variant of BRKGA for one population, with no generations. BRKGA::evolve decodes a
+ * whole generation in parallel and then sorts it, so each generation waits for its slowest
+ * decode. Here MAX_THREADS workers each repeat, on their own: take an elite and a non-elite
+ * parent, mate them as BRKGA does (or draw a mutant, with the share of mutants of a BRKGA
+ * generation), decode the offspring and insert it.
+ *
+ * The population is split at the elite boundary:
+ * - the elite set, the pe best chromosomes by increasing fitness, under a lock of its own. An
+ *   offspring better than the worst elite chromosome takes its place in the elite set, and the
+ *   one it pushed out goes down to the non-elite slot the offspring would have taken;
+ * - the p - pe non-elite slots, with one lock each, overwritten in turn as a ring. A non-elite
+ *   chromosome thus lives for about p - pe insertions, as for one generation of BRKGA.
+ * Chromosomes do not change once inserted and are held through shared_ptr: a worker only holds a
+ * lock to copy a pointer, and reads its parents with no lock held. The fitness of the worst elite
+ * chromosome is mirrored in an atomic, so offspring that stay out of the elite set never take
+ * its lock.
+ *
+ * Stopping criteria count evaluations (decoded offspring) rather than generations. With one
+ * thread, a run is a deterministic function of the generator given to the constructor.
+ *
+ * Decoder: as for BRKGA, decode must be thread-safe; decodeBatch is used when it is there, each
+ * worker then decoding BATCH offspring per round.
+ */
+
+#ifndef ASYNC_BRKGA_H
+#define ASYNC_BRKGA_H
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include "BRKGA.h"
+
+template< class Decoder, class RNG >
+class AsyncBRKGA {
+public:
+	typedef std::vector< double > Chromosome;
+
+	/*
+	 * Parameters as for BRKGA, with a single population; p random chromosomes are drawn from
+	 * refRNG and decoded
+	 */
+	AsyncBRKGA(unsigned n, unsigned p, double pe, double pm, double rhoe, const Decoder& refDecoder,
+			RNG& refRNG, unsigned MAX_THREADS = 1);
+
+	/**
+	 * Inject a chromosome in place of the worst one, e.g. to warm start the search; not during
+	 * evolve
+	 * @param chromosome n keys in [0, 1)
+	 */
+	void injectChromosome(const Chromosome& chromosome);
+
+	/**
+	 * Run the workers until 'evaluations' offspring have been decoded, until 'stagnation'
+	 * offspring in a row leave the best fitness as it was, or until improved returns true.
+	 * improved(fitness, evaluation) is called at every new best fitness, one call at a time,
+	 * with the number of offspring decoded so far; it may call snapshot.
+	 */
+	template< class Improved >
+	void evolve(unsigned long evaluations, unsigned long stagnation, Improved improved);
+
+	/**
+	 * Every chromosome of the population, the elite set first by increasing fitness; each part
+	 * is read under its lock, so this is safe during evolve
+	 */
+	std::vector< std::shared_ptr< const Chromosome > > snapshot() const;
+
+	// Not during evolve:
+	const Chromosome& getBestChromosome() const;
+	double getBestFitness() const;
+
+	// Offspring decoded by all calls of evolve
+	unsigned long getEvaluations() const;
+
+	unsigned getN() const;
+	unsigned getP() const;
+	unsigned getPe() const;
+	unsigned getPm() const;
+	double getRhoe() const;
+	unsigned getMAX_THREADS() const;
+
+private:
+	struct Entry {
+		double fitness;
+		std::shared_ptr< const Chromosome > chromosome;
+	};
+
+	struct Slot {
+		mutable std::mutex mutex;
+		Entry entry;
+	};
+
+	// Hyperparameters:
+	const unsigned n;	// number of genes in the chromosome
+	const unsigned p;	// number of elements in the population
+	const unsigned pe;	// number of elite items in the population
+	const unsigned pm;	// number of mutants among every p - pe offspring
+	const double rhoe;	// probability that an offspring inherits the allele of its elite parent
+
+	RNG& refRNG;				// draws the first population and the seeds of the workers
+	const Decoder& refDecoder;
+	const unsigned MAX_THREADS;	// number of workers
+
+	// Data:
+	mutable std::mutex eliteMutex;
+	std::vector< Entry > elite;					// the pe best, by increasing fitness
+	std::atomic< double > worstElite;			// elite.back().fitness
+	std::vector< Slot > rest;					// the p - pe others
+	std::atomic< unsigned long > nextSlot;		// the ring position of the next insertion
+	std::atomic< unsigned long > evaluations;
+
+	// Chromosomes per decode call
+	static constexpr unsigned batch();
+
+	// fitness[k] of *chromosomes[k], k < count <= batch()
+	void decode(const Chromosome* const* chromosomes, unsigned count, double* fitness) const;
+
+	// Offspring 'entry' enters the elite set, or rest[slot]; safe during evolve
+	void insert(Entry entry, unsigned slot);
+};
+
+template< class Decoder, class RNG >
+AsyncBRKGA< Decoder, RNG >::AsyncBRKGA(unsigned _n, unsigned _p, double _pe, double _pm, double _rhoe,
+		const Decoder& decoder, RNG& rng, unsigned MAX) :
+		n(_n), p(_p), pe(unsigned(_pe * p)), pm(unsigned(_pm * p)), rhoe(_rhoe), refRNG(rng),
+		refDecoder(decoder), MAX_THREADS(MAX), worstElite(0.0), rest(p > pe ? p - pe : 0),
+		nextSlot(0), evaluations(0) {
+	// Error check:
+	using std::range_error;
+	if(n == 0) { throw range_error("Chromosome size equals zero."); }
+	if(p == 0) { throw range_error("Population size equals zero."); }
+	if(pe == 0) { throw range_error("Elite-set size equals zero."); }
+	if(pe >= p) { throw range_error("Elite-set size not smaller than population size (pe >= p)."); }
+	if(pe + pm > p) { throw range_error("elite + mutant sets greater than population size (p)."); }
+
+	// Draw and decode the first population, then split it at the elite boundary:
+	std::vector< Entry > entries(p);
+	for(Entry& entry : entries) {
+		std::shared_ptr< Chromosome > chromosome = std::make_shared< Chromosome >(n);
+		for(double& key : *chromosome) { key = refRNG.rand(); }
+		entry.chromosome = chromosome;
+	}
+	PROFILE_COUNT("rng.draws", p * n);
+
+	const int batches = int((p + batch() - 1) / batch());
+	#ifdef _OPENMP
+		#pragma omp parallel for num_threads(MAX_THREADS)
+	#endif
+	for(int b = 0; b < batches; ++b) {
+		const unsigned first = unsigned(b) * batch();
+		const unsigned count = std::min(batch(), p - first);
+		const Chromosome* chromosomes[batch()];
+		double fitness[batch()];
+		for(unsigned k = 0; k < count; ++k) { chromosomes[k] = entries[first + k].chromosome.get(); }
+		decode(chromosomes, count, fitness);
+		for(unsigned k = 0; k < count; ++k) { entries[first + k].fitness = fitness[k]; }
+	}
+	PROFILE_COUNT("decoder.calls", p);
+
+	std::stable_sort(entries.begin(), entries.end(),
+			[](const Entry& a, const Entry& b) { return a.fitness < b.fitness; });
+	elite.assign(entries.begin(), entries.begin() + pe);
+	for(unsigned i = 0; i < p - pe; ++i) { rest[i].entry = entries[pe + i]; }
+	worstElite.store(elite.back().fitness, std::memory_order_relaxed);
+}
+
+template< class Decoder, class RNG >
+void AsyncBRKGA< Decoder, RNG >::injectChromosome(const Chromosome& chromosome) {
+	#ifdef RANGECHECK
+		if(chromosome.size() != n) { throw std::range_error("Chromosome size differs from n."); }
+	#endif
+
+	Entry entry;
+	entry.chromosome = std::make_shared< const Chromosome >(chromosome);
+	entry.fitness = refDecoder.decode(chromosome);
+	PROFILE_COUNT("decoder.calls", 1);
+
+	// The worst chromosome is the worst non-elite one:
+	unsigned worst = 0;
+	for(unsigned i = 1; i < p - pe; ++i) {
+		if(rest[i].entry.fitness > rest[worst].entry.fitness) { worst = i; }
+	}
+	insert(entry, worst);
+}
+
+template< class Decoder, class RNG >
+template< class Improved >
+void AsyncBRKGA< Decoder, RNG >::evolve(unsigned long maxEvaluations, unsigned long stagnation,
+		Improved improved) {
+	const unsigned long start = evaluations.load();
+	if(maxEvaluations == 0) { return; }
+
+	std::atomic< bool > stop(false);
+	// Counts since start, signed: a worker may compare its count with the later one of another
+	std::atomic< long long > lastImprovement(0);
+	std::atomic< double > best(getBestFitness());
+	std::mutex bestMutex;	// orders the calls of improved
+
+	// One generator per worker, seeded in turn from refRNG:
+	std::vector< RNG > rngs;
+	for(unsigned t = 0; t < MAX_THREADS; ++t) { rngs.emplace_back(refRNG.randInt()); }
+
+	const double mutantRate = double(pm) / (p - pe);
+	const long long budget = (long long) std::min< unsigned long >(maxEvaluations, std::numeric_limits< long long >::max());
+	const long long patience = (long long) std::min< unsigned long >(stagnation, std::numeric_limits< long long >::max());
+
+	auto work = [&](unsigned t) {
+		RNG& rng = rngs[t];
+		std::shared_ptr< Chromosome > offspring[batch()];
+		const Chromosome* chromosomes[batch()];
+		double fitness[batch()];
+
+		while(!stop.load(std::memory_order_relaxed)) {
+			PROFILE_SCOPE("brkga.async_round");
+			for(unsigned k = 0; k < batch(); ++k) {
+				offspring[k] = std::make_shared< Chromosome >(n);
+				Chromosome& child = *offspring[k];
+				if(rng.rand() < mutantRate) {
+					for(double& key : child) { key = rng.rand(); }
+					PROFILE_COUNT("rng.draws", n + 1);
+				} else {
+					std::shared_ptr< const Chromosome > eliteParent;
+					{
+						std::lock_guard< std::mutex > lock(eliteMutex);
+						eliteParent = elite[rng.randInt(pe - 1)].chromosome;
+					}
+					std::shared_ptr< const Chromosome > noneliteParent;
+					{
+						const Slot& slot = rest[rng.randInt(p - pe - 1)];
+						std::lock_guard< std::mutex > lock(slot.mutex);
+						noneliteParent = slot.entry.chromosome;
+					}
+					for(unsigned j = 0; j < n; ++j) {
+						child[j] = (rng.rand() < rhoe) ? (*eliteParent)[j] : (*noneliteParent)[j];
+					}
+					PROFILE_COUNT("rng.draws", n + 3);
+				}
+				chromosomes[k] = offspring[k].get();
+			}
+
+			decode(chromosomes, batch(), fitness);
+			PROFILE_COUNT("decoder.calls", batch());
+
+			for(unsigned k = 0; k < batch(); ++k) {
+				insert(Entry{fitness[k], std::move(offspring[k])}, unsigned(nextSlot++ % (p - pe)));
+				const long long count = (long long) (++evaluations - start);
+
+				if(fitness[k] < best.load(std::memory_order_relaxed)) {
+					std::lock_guard< std::mutex > lock(bestMutex);
+					if(fitness[k] < best.load(std::memory_order_relaxed)) {
+						best.store(fitness[k], std::memory_order_relaxed);
+						lastImprovement.store(count, std::memory_order_relaxed);
+						if(improved(fitness[k], (unsigned long) count)) { stop = true; }
+					}
+				}
+				if(count >= budget || count - lastImprovement.load(std::memory_order_relaxed) >= patience) {
+					stop = true;
+				}
+				if(stop.load(std::memory_order_relaxed)) { break; }
+			}
+		}
+	};
+
+	#ifdef _OPENMP
+		#pragma omp parallel num_threads(MAX_THREADS)
+		work(unsigned(omp_get_thread_num()));
+	#else
+		work(0);
+	#endif
+}
+
+template< class Decoder, class RNG >
+std::vector< std::shared_ptr< const typename AsyncBRKGA< Decoder, RNG >::Chromosome > >
+AsyncBRKGA< Decoder, RNG >::snapshot() const {
+	std::vector< std::shared_ptr< const Chromosome > > chromosomes;
+	chromosomes.reserve(p);
+	{
+		std::lock_guard< std::mutex > lock(eliteMutex);
+		for(const Entry& entry : elite) { chromosomes.push_back(entry.chromosome); }
+	}
+	for(const Slot& slot : rest) {
+		std::lock_guard< std::mutex > lock(slot.mutex);
+		chromosomes.push_back(slot.entry.chromosome);
+	}
+	return chromosomes;
+}
+
+template< class Decoder, class RNG >
+const typename AsyncBRKGA< Decoder, RNG >::Chromosome& AsyncBRKGA< Decoder, RNG >::getBestChromosome() const {
+	return *elite.front().chromosome;
+}
+
+template< class Decoder, class RNG >
+double AsyncBRKGA< Decoder, RNG >::getBestFitness() const {
+	std::lock_guard< std::mutex > lock(eliteMutex);
+	return elite.front().fitness;
+}
+
+template< class Decoder, class RNG >
+unsigned long AsyncBRKGA< Decoder, RNG >::getEvaluations() const { return evaluations.load(); }
+
+template< class Decoder, class RNG >
+constexpr unsigned AsyncBRKGA< Decoder, RNG >::batch() {
+	if constexpr (HasDecodeBatch< Decoder >::value) {
+		return Decoder::BATCH;
+	} else {
+		return 1;
+	}
+}
+
+template< class Decoder, class RNG >
+inline void AsyncBRKGA< Decoder, RNG >::decode(const Chromosome* const* chromosomes, unsigned count,
+		double* fitness) const {
+	if constexpr (HasDecodeBatch< Decoder >::value) {
+		refDecoder.decodeBatch(chromosomes, count, fitness);
+	} else {
+		for(unsigned k = 0; k < count; ++k) { fitness[k] = refDecoder.decode(*chromosomes[k]); }
+	}
+}
+
+template< class Decoder, class RNG >
+void AsyncBRKGA< Decoder, RNG >::insert(Entry entry, unsigned slot) {
+	// Across the elite boundary: the offspring takes its rank and the worst elite one moves down
+	if(entry.fitness < worstElite.load(std::memory_order_relaxed)) {
+		std::lock_guard< std::mutex > lock(eliteMutex);
+		if(entry.fitness < elite.back().fitness) {
+			const size_t rank = std::upper_bound(elite.begin(), elite.end(), entry.fitness,
+					[](double fitness, const Entry& other) { return fitness < other.fitness; }) - elite.begin();
+			Entry displaced = std::move(elite.back());
+			elite.pop_back();
+			elite.insert(elite.begin() + rank, std::move(entry));
+			worstElite.store(elite.back().fitness, std::memory_order_relaxed);
+			entry = std::move(displaced);
+		}
+	}
+
+	// The chromosome replaced here is freed after the lock, unless a worker still reads it
+	Entry replaced;
+	{
+		std::lock_guard< std::mutex > lock(rest[slot].mutex);
+		replaced = std::move(rest[slot].entry);
+		rest[slot].entry = std::move(entry);
+	}
+}
+
+template< class Decoder, class RNG >
+unsigned AsyncBRKGA< Decoder, RNG >::getN() const { return n; }
+
+template< class Decoder, class RNG >
+unsigned AsyncBRKGA< Decoder, RNG >::getP() const { return p; }
+
+template< class Decoder, class RNG >
+unsigned AsyncBRKGA< Decoder, RNG >::getPe() const { return pe; }
+
+template< class Decoder, class RNG >
+unsigned AsyncBRKGA< Decoder, RNG >::getPm() const { return pm; }
+
+template< class Decoder, class RNG >
+double AsyncBRKGA< Decoder, RNG >::getRhoe() const { return rhoe; }
+
+template< class Decoder, class RNG >
+unsigned AsyncBRKGA< Decoder, RNG >::getMAX_THREADS() const { return MAX_THREADS; }
+
+#endif
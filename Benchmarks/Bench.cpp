@@ -0,0 +1,165 @@
+#include "Bench.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// A few graphs of each base, from small to large
+const char* DEFAULT_GRAPHS[][2] = {
+    {"DIMACS", "queen14_14.txt"},
+    {"DIMACS", "le450_5d.txt"},
+    {"Harwell-Boeing", "dwt__310.txt"},
+    {"Harwell-Boeing", "jagmesh1.txt"},
+    {"Random_graphs", "cubic_276.txt"},
+    {"Random_graphs", "rd_200_0.8.txt"},
+};
+
+const int SYNTHETIC_ORDERS[] = {128, 512, 2048};
+const double SYNTHETIC_DENSITIES[] = {0.01, 0.05, 0.2};
+
+std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+}
+
+Instance loadInstance(const std::string& path, const std::string& source) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Error opening file: " + path);
+    }
+
+    Instance instance;
+    instance.name = fs::path(path).stem().string();
+    instance.source = source;
+    instance.path = path;
+    file >> instance.n >> instance.m;
+    int u, v;
+    while (file >> u >> v) instance.edges.push_back({u, v});
+    instance.m = instance.edges.size();
+    return instance;
+}
+
+Instance randomInstance(int n, double density, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution edge(density);
+
+    std::ostringstream name;
+    name << "gnp_" << n << "_" << density;
+
+    Instance instance;
+    instance.name = name.str();
+    instance.source = "synthetic";
+    instance.n = n;
+    for (int u = 0; u < n; u++) {
+        for (int v = u + 1; v < n; v++) {
+            if (edge(rng)) instance.edges.push_back({u, v});
+        }
+    }
+    instance.m = instance.edges.size();
+
+    // The loaders read files, so the graph is written out as well
+    instance.path = (fs::temp_directory_path() / ("prd_bench_" + instance.name + ".txt")).string();
+    std::ofstream file(instance.path);
+    file << instance.n << " " << instance.m << "\n";
+    for (const auto& [a, b] : instance.edges) file << a << " " << b << "\n";
+    return instance;
+}
+
+Bench::Bench(const std::string& suite, int argc, char* argv[]) : suite(suite) {
+    std::string base = "../Graph-base/Coleta-das-Bases";
+    std::vector<std::string> files;
+    bool quick = false;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) {
+            this->jsonPath = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            this->minTime = std::stod(argv[++i]);
+        } else if (arg == "--filter" && i + 1 < argc) {
+            this->filter = argv[++i];
+        } else if (arg == "--graphs" && i + 1 < argc) {
+            files = splitList(argv[++i]);
+        } else if (arg == "--base" && i + 1 < argc) {
+            base = argv[++i];
+        } else if (arg == "--quick") {
+            quick = true;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--json FILE] [--min-time SECONDS] [--filter TEXT]"
+                      << " [--graphs FILE,...] [--base DIR] [--quick]" << std::endl;
+            exit(1);
+        }
+    }
+
+    if (!files.empty()) {
+        for (const std::string& file : files) this->graphs.push_back(loadInstance(file, "file"));
+        return;
+    }
+
+    if (!quick) {
+        for (const auto& graph : DEFAULT_GRAPHS) {
+            const fs::path path = fs::path(base) / graph[0] / "base_final" / graph[1];
+            if (fs::exists(path)) {
+                this->graphs.push_back(loadInstance(path.string(), graph[0]));
+            } else {
+                std::cerr << "Skipping missing instance " << path << std::endl;
+            }
+        }
+    }
+    for (int n : SYNTHETIC_ORDERS) {
+        if (quick && n > 512) continue;
+        for (double density : SYNTHETIC_DENSITIES) {
+            this->graphs.push_back(randomInstance(n, density, n * 1000 + static_cast<unsigned>(density * 1000)));
+        }
+    }
+}
+
+bool Bench::enabled(const std::string& name) const {
+    return this->filter.empty() || name.find(this->filter) != std::string::npos;
+}
+
+void Bench::record(const std::string& name, const Instance& instance, long long iterations, std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    BenchResult result{name, instance.name, instance.n, instance.m, iterations,
+        samples[samples.size() / 2], samples.front(), samples.back()};
+    this->results.push_back(result);
+
+    std::cout << std::left << std::setw(34) << name << std::setw(22) << instance.name
+              << std::right << std::setw(14) << std::fixed << std::setprecision(1) << result.nsPerOp << " ns"
+              << std::setw(12) << iterations << " it" << std::endl;
+}
+
+void Bench::finish() const {
+    if (this->jsonPath.empty()) return;
+
+    std::ofstream file(this->jsonPath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Error opening file: " + this->jsonPath);
+    }
+    file << "{\n  \"suite\": \"" << this->suite << "\",\n  \"min_time\": " << this->minTime << ",\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < this->results.size(); i++) {
+        const BenchResult& r = this->results[i];
+        file << "    {\"name\": \"" << r.name << "\", \"instance\": \"" << r.instance
+             << "\", \"n\": " << r.n << ", \"m\": " << r.m << ", \"iterations\": " << r.iterations
+             << ", \"ns_per_op\": " << r.nsPerOp << ", \"ns_min\": " << r.nsMin << ", \"ns_max\": " << r.nsMax << "}"
+             << (i + 1 < this->results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+    std::cout << "Results written to " << this->jsonPath << std::endl;
+}
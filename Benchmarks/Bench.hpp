@@ -0,0 +1,133 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Self-contained micro-benchmark harness. Every benchmark runs on every
+// instance: a few graphs of each base in Graph-base plus Erdos-Renyi graphs of
+// growing order and density. Results are printed as a table and written as
+// JSON, so that runs before and after a change can be compared.
+//
+// Options of every benchmark binary:
+//   --json FILE          write the results to FILE
+//   --min-time SECONDS   measuring time per benchmark and instance (0.2)
+//   --filter TEXT        only benchmarks whose name contains TEXT
+//   --graphs FILE,...    instance files instead of the default selection
+//   --base DIR           Graph-base directory (../Graph-base/Coleta-das-Bases)
+//   --quick              small synthetic graphs only
+
+struct Instance {
+    std::string name;
+    std::string source;     // DIMACS, Harwell-Boeing, Random_graphs, synthetic or file
+    std::string path;       // graph file, for the loader benchmarks
+    int n = 0;
+    int m = 0;
+    std::vector<std::pair<int, int>> edges;
+};
+
+struct BenchResult {
+    std::string name;
+    std::string instance;
+    int n;
+    int m;
+    long long iterations;
+    double nsPerOp;         // median over the samples
+    double nsMin;
+    double nsMax;
+};
+
+// Keeps the compiler from discarding a computation whose result is unused
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+class Bench {
+    public:
+        Bench(const std::string& suite, int argc, char* argv[]);
+
+        const std::vector<Instance>& instances() const { return this->graphs; }
+        bool enabled(const std::string& name) const;
+
+        // Times 'body' in batches large enough for the clock to be accurate.
+        template <typename Body>
+        void run(const std::string& name, const Instance& instance, Body body);
+
+        // Calls the untimed 'setup' before each timed call of 'body', for
+        // operations that change their input.
+        template <typename Setup, typename Body>
+        void run(const std::string& name, const Instance& instance, Setup setup, Body body);
+
+        // Prints the table and writes the JSON file, if one was asked for.
+        void finish() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        std::string suite;
+        std::string jsonPath;
+        std::string filter;
+        double minTime = 0.2;
+        std::vector<Instance> graphs;
+        std::vector<BenchResult> results;
+
+        void record(const std::string& name, const Instance& instance, long long iterations, std::vector<double> samples);
+};
+
+Instance loadInstance(const std::string& path, const std::string& source);
+
+// G(n, p) graph with p = density, also written to a temporary file
+Instance randomInstance(int n, double density, unsigned seed);
+
+template <typename Body>
+void Bench::run(const std::string& name, const Instance& instance, Body body) {
+    if (!this->enabled(name)) return;
+
+    // Grow the batch until it takes about a millisecond
+    long long batch = 1;
+    while (true) {
+        const auto begin = Clock::now();
+        for (long long i = 0; i < batch; i++) body();
+        const double elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+        if (elapsed >= 1e-3 || batch >= (1LL << 30)) break;
+        batch *= 2;
+    }
+
+    std::vector<double> samples;
+    long long iterations = 0;
+    double total = 0.0;
+    while (total < this->minTime || samples.size() < 5) {
+        const auto begin = Clock::now();
+        for (long long i = 0; i < batch; i++) body();
+        const double elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+        samples.push_back(elapsed * 1e9 / batch);
+        iterations += batch;
+        total += elapsed;
+    }
+    this->record(name, instance, iterations, std::move(samples));
+}
+
+template <typename Setup, typename Body>
+void Bench::run(const std::string& name, const Instance& instance, Setup setup, Body body) {
+    if (!this->enabled(name)) return;
+
+    // The setup is not timed, but it still bounds the wall time
+    std::vector<double> samples;
+    double total = 0.0;
+    const auto start = Clock::now();
+    while (samples.size() < 5 || (total < this->minTime
+        && std::chrono::duration<double>(Clock::now() - start).count() < 5 * this->minTime)) {
+        setup();
+        const auto begin = Clock::now();
+        body();
+        const double elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+        samples.push_back(elapsed * 1e9);
+        total += elapsed;
+    }
+    const long long iterations = samples.size();
+    this->record(name, instance, iterations, std::move(samples));
+}
+
+#endif
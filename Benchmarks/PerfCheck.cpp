@@ -0,0 +1,188 @@
+#include "PerfCheck.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Sparse and dense graphs of each base, a few hundred vertices each
+const char* PERF_GRAPHS[][2] = {
+    {"Harwell-Boeing", "dwt__310.txt"},
+    {"Harwell-Boeing", "jagmesh1.txt"},
+    {"DIMACS", "le450_5d.txt"},
+    {"Random_graphs", "cubic_276.txt"},
+};
+
+// Value of "key" in a one-line JSON object written by PerfCheck::write
+std::string field(const std::string& line, const std::string& key) {
+    const std::string pattern = "\"" + key + "\": ";
+    size_t begin = line.find(pattern);
+    if (begin == std::string::npos) return "";
+    begin += pattern.size();
+    if (line[begin] == '"') {
+        const size_t end = line.find('"', begin + 1);
+        return line.substr(begin + 1, end - begin - 1);
+    }
+    const size_t end = line.find_first_of(",}", begin);
+    return line.substr(begin, end - begin);
+}
+
+}
+
+PerfOptions parsePerfOptions(int argc, char* argv[]) {
+    PerfOptions options;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--baseline" && i + 1 < argc) {
+            options.baseline = argv[++i];
+        } else if (arg == "--write" && i + 1 < argc) {
+            options.output = argv[++i];
+        } else if (arg == "--tolerance" && i + 1 < argc) {
+            options.tolerance = std::stod(argv[++i]);
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            options.repetitions = std::stoi(argv[++i]);
+        } else if (arg == "--base" && i + 1 < argc) {
+            options.base = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--baseline FILE] [--write FILE] [--tolerance VALUE]"
+                      << " [--repetitions VALUE] [--base DIR]" << std::endl;
+            exit(1);
+        }
+    }
+    return options;
+}
+
+std::vector<std::string> perfInstances(const std::string& base) {
+    std::vector<std::string> paths;
+    for (const auto& graph : PERF_GRAPHS) {
+        const fs::path path = fs::path(base) / graph[0] / "base_final" / graph[1];
+        if (!fs::exists(path)) {
+            throw std::runtime_error("Missing perf-check instance: " + path.string());
+        }
+        paths.push_back(path.string());
+    }
+    return paths;
+}
+
+void PerfCheck::add(const std::string& algorithm, const std::string& instance, const std::string& metric, double value) {
+    this->samples[{algorithm, instance, metric}].push_back(value);
+}
+
+void PerfCheck::addFitness(const std::string& algorithm, const std::string& instance, int seed, int value) {
+    this->fitness[{algorithm, instance, seed}] = value;
+}
+
+PerfCheck::Summary PerfCheck::summarise(std::vector<double> values) {
+    Summary summary;
+    summary.samples = values.size();
+    if (values.empty()) return summary;
+
+    auto median = [](std::vector<double>& v) {
+        std::sort(v.begin(), v.end());
+        const size_t k = v.size() / 2;
+        return v.size() % 2 == 1 ? v[k] : (v[k - 1] + v[k]) / 2;
+    };
+    summary.median = median(values);
+    for (double& value : values) value = std::fabs(value - summary.median);
+    summary.mad = median(values);
+    return summary;
+}
+
+void PerfCheck::print() const {
+    for (const auto& [key, values] : this->samples) {
+        const Summary summary = summarise(values);
+        std::cout << std::left << std::setw(8) << std::get<0>(key) << std::setw(18) << std::get<1>(key)
+                  << std::setw(24) << std::get<2>(key) << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << summary.median << " +- " << summary.mad << std::endl;
+    }
+}
+
+void PerfCheck::write(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Error opening file: " + path);
+    }
+
+    file << "{\n  \"suite\": \"" << this->suite << "\",\n  \"metrics\": [\n";
+    size_t i = 0;
+    for (const auto& [key, values] : this->samples) {
+        const Summary summary = summarise(values);
+        file << "    {\"algorithm\": \"" << std::get<0>(key) << "\", \"instance\": \"" << std::get<1>(key)
+             << "\", \"metric\": \"" << std::get<2>(key) << "\", \"median\": " << summary.median
+             << ", \"mad\": " << summary.mad << ", \"samples\": " << summary.samples << "}"
+             << (++i < this->samples.size() ? "," : "") << "\n";
+    }
+    file << "  ],\n  \"fitness\": [\n";
+    i = 0;
+    for (const auto& [key, value] : this->fitness) {
+        file << "    {\"algorithm\": \"" << std::get<0>(key) << "\", \"instance\": \"" << std::get<1>(key)
+             << "\", \"seed\": " << std::get<2>(key) << ", \"fitness\": " << value << "}"
+             << (++i < this->fitness.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+    std::cout << "Baseline written to " << path << std::endl;
+}
+
+bool PerfCheck::compare(const std::string& baselinePath, double tolerance) const {
+    std::ifstream file(baselinePath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Error opening file: " + baselinePath);
+    }
+
+    std::map<Key, Summary> baseline;
+    std::map<std::tuple<std::string, std::string, int>, int> baselineFitness;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!field(line, "metric").empty()) {
+            Summary summary;
+            summary.median = std::stod(field(line, "median"));
+            summary.mad = std::stod(field(line, "mad"));
+            summary.samples = std::stoi(field(line, "samples"));
+            baseline[{field(line, "algorithm"), field(line, "instance"), field(line, "metric")}] = summary;
+        } else if (!field(line, "seed").empty()) {
+            baselineFitness[{field(line, "algorithm"), field(line, "instance"), std::stoi(field(line, "seed"))}] =
+                std::stoi(field(line, "fitness"));
+        }
+    }
+
+    bool passed = true;
+    for (const auto& [key, values] : this->samples) {
+        const Summary current = summarise(values);
+        auto it = baseline.find(key);
+        std::cout << std::left << std::setw(8) << std::get<0>(key) << std::setw(18) << std::get<1>(key)
+                  << std::setw(24) << std::get<2>(key) << std::right << std::fixed << std::setprecision(1);
+        if (it == baseline.end()) {
+            std::cout << std::setw(14) << current.median << "  (not in the baseline)" << std::endl;
+            continue;
+        }
+
+        const Summary& reference = it->second;
+        const double noise = 3 * 1.4826 * std::max(reference.mad, current.mad);
+        const double threshold = std::max(tolerance * reference.median, noise);
+        const double change = reference.median > 0 ? (current.median - reference.median) / reference.median : 0.0;
+        const bool regressed = current.median < reference.median - threshold;
+        passed = passed && !regressed;
+
+        std::cout << std::setw(14) << current.median << " vs " << std::setw(12) << reference.median
+                  << std::showpos << std::setw(8) << 100 * change << "%" << std::noshowpos
+                  << (regressed ? "  REGRESSION" : "") << std::endl;
+    }
+
+    for (const auto& [key, value] : this->fitness) {
+        auto it = baselineFitness.find(key);
+        if (it != baselineFitness.end() && it->second != value) {
+            std::cout << "Note: " << std::get<0>(key) << " on " << std::get<1>(key) << " with seed " << std::get<2>(key)
+                      << " now reaches " << value << " instead of " << it->second << std::endl;
+        }
+    }
+
+    std::cout << (passed ? "perf-check passed" : "perf-check FAILED") << std::endl;
+    return passed;
+}
@@ -0,0 +1,69 @@
+#ifndef PERF_CHECK_HPP
+#define PERF_CHECK_HPP
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Throughput regression gate. A perf binary runs a fixed set of instances and
+// seeds for a fixed number of generations, so that every run does the same
+// work, and records throughput samples (generations, decodes or repairs per
+// second) together with the best weight of each run.
+//
+// Samples of the same algorithm, instance and metric are summarised by their
+// median and median absolute deviation. A metric regresses when the current
+// median falls below the baseline median by more than
+//     max(tolerance * baseline median, 3 * 1.4826 * max(baseline MAD, current MAD)),
+// so noisy metrics get a wider band than stable ones. A best weight that
+// differs from the baseline means the search itself changed; it is reported
+// but does not fail the check.
+//
+// Options of every perf binary:
+//   --baseline FILE      compare with FILE; the exit status is 1 on a regression
+//   --write FILE         store the results as the new baseline
+//   --tolerance VALUE    minimum relative slowdown that counts (0.10)
+//   --repetitions VALUE  runs of every instance and seed (3)
+//   --base DIR           Graph-base directory (../Graph-base/Coleta-das-Bases)
+
+struct PerfOptions {
+    std::string baseline;
+    std::string output;
+    std::string base = "../Graph-base/Coleta-das-Bases";
+    double tolerance = 0.10;
+    int repetitions = 3;
+};
+
+PerfOptions parsePerfOptions(int argc, char* argv[]);
+
+// The fixed instances of the gate, as paths under 'base'
+std::vector<std::string> perfInstances(const std::string& base);
+
+class PerfCheck {
+    public:
+        explicit PerfCheck(const std::string& suite) : suite(suite) {}
+
+        void add(const std::string& algorithm, const std::string& instance, const std::string& metric, double value);
+        void addFitness(const std::string& algorithm, const std::string& instance, int seed, int fitness);
+
+        // Prints the comparison; returns false when some metric regressed.
+        bool compare(const std::string& baselinePath, double tolerance) const;
+        void write(const std::string& path) const;
+        void print() const;
+
+    private:
+        using Key = std::tuple<std::string, std::string, std::string>;  // algorithm, instance, metric
+
+        struct Summary {
+            double median = 0.0;
+            double mad = 0.0;
+            int samples = 0;
+        };
+
+        std::string suite;
+        std::map<Key, std::vector<double>> samples;
+        std::map<std::tuple<std::string, std::string, int>, int> fitness;   // algorithm, instance, seed
+
+        static Summary summarise(std::vector<double> values);
+};
+
+#endif
@@ -0,0 +1,100 @@
+#include "Bench.hpp"
+#include "../BRKGA/Graph.h"
+#include "../BRKGA/DecoderRoman.h"
+#include "../BRKGA/brkgaAPI/BRKGA.h"
+#include "../BRKGA/brkgaAPI/MTRand.h"
+#include "../Common/Reorder.hpp"
+#include <algorithm>
+
+// BRKGA kernels: graph loading, the decoder and its weight-reduction pass,
+// and one generation of the BRKGA with the default parameters of
+// brkga-perfect-roman.
+int main(int argc, char* argv[]) {
+    Bench bench("brkga", argc, argv);
+
+    for (const Instance& instance : bench.instances()) {
+        bench.run("brkga.load", instance, [&]() {
+            Graph graph(instance.path);
+            doNotOptimize(graph.getOrder());
+        });
+
+        const Graph graph(instance.path);
+        const unsigned n = graph.getOrder();
+        DecoderRoman decoder(graph);
+        MTRand rng(n);
+
+        std::vector<std::vector<double>> chromosomes(16, std::vector<double>(n));
+        for (std::vector<double>& chromosome : chromosomes) {
+            for (double& key : chromosome) key = rng.rand();
+        }
+        size_t next = 0;
+
+        bench.run("decoder.decode", instance, [&]() {
+            doNotOptimize(decoder.decode(chromosomes[next++ % chromosomes.size()]));
+        });
+
+        // The same chromosomes, BATCH per call: the time is for BATCH decodings
+        bench.run("decoder.decode_batch", instance, [&]() {
+            const std::vector<double>* batch[DecoderRoman::BATCH];
+            double fitness[DecoderRoman::BATCH];
+            for (unsigned k = 0; k < DecoderRoman::BATCH; k++) batch[k] = &chromosomes[next++ % chromosomes.size()];
+            decoder.decodeBatch(batch, DecoderRoman::BATCH, fitness);
+            doNotOptimize(fitness[0]);
+        });
+
+        // Random labellings with the dominance numbers the decoder would keep:
+        // one for a labelled vertex itself plus one per neighbour labelled 2
+        std::vector<Labelling> labelPool(16, Labelling(n));
+        std::vector<std::vector<int>> dominancePool(16, std::vector<int>(n, 0));
+        for (size_t k = 0; k < labelPool.size(); k++) {
+            for (unsigned u = 0; u < n; u++) labelPool[k][u] = rng.randInt(2);
+            for (unsigned u = 0; u < n; u++) {
+                if (labelPool[k][u] > 0) dominancePool[k][u]++;
+                if (labelPool[k][u] != 2) continue;
+                for (size_t v : graph.getNeighbors(u)) dominancePool[k][v]++;
+            }
+        }
+        Labelling labels;
+        std::vector<int> dominance;
+
+        bench.run("decoder.reduce_weight_heuristic", instance,
+            [&]() {
+                labels = labelPool[next % labelPool.size()];
+                dominance = dominancePool[next++ % dominancePool.size()];
+            },
+            [&]() {
+                reduce_weight_heuristic(decoder.adjacency(), labels, dominance);
+                doNotOptimize(labels.data());
+            });
+
+        // Population size as in brkga-perfect-roman, one decoding thread
+        const double pe = 0.20;
+        const unsigned populationSize = std::max(n / 100, static_cast<unsigned>(std::ceil(1.0 / pe)) + 1);
+        BRKGA<DecoderRoman, MTRand> algorithm(n, populationSize, pe, 0.10, 0.70, decoder, rng, 2, 1);
+
+        bench.run("brkga.evolution", instance, [&]() {
+            algorithm.evolve();
+        });
+
+        // The decoder on the graph relabelled by --order: the same keys, with
+        // the neighbours of a vertex at nearby ids
+        for (VertexOrder order : {VertexOrder::RCM, VertexOrder::DEGREE, VertexOrder::BFS}) {
+            const VertexOrdering ordering(decoder.adjacency(), order);
+            Graph relabelled;
+            for (unsigned u = 0; u < n; u++) relabelled.addVertex(u);
+            for (unsigned u = 0; u < n; u++) {
+                for (int v : ordering.graph()[u]) {
+                    if (u < static_cast<unsigned>(v)) relabelled.addEdge(u, v);
+                }
+            }
+            DecoderRoman relabelledDecoder(relabelled);
+
+            bench.run("decoder.decode." + vertexOrderName(order), instance, [&]() {
+                doNotOptimize(relabelledDecoder.decode(chromosomes[next++ % chromosomes.size()]));
+            });
+        }
+    }
+
+    bench.finish();
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "Bench.hpp"
+#include "../GA-CPP/Graph.hpp"
+#include "../GA-CPP/PRD.hpp"
+#include "../GA-CPP/Solution.hpp"
+#include "../Common/Reorder.hpp"
+#include <algorithm>
+#include <random>
+
+// GA-CPP kernels: graph loading, the greedy and GRASP constructions and the PRD repair
+// operators that run on every new individual.
+int main(int argc, char* argv[]) {
+    Bench bench("ga", argc, argv);
+
+    for (const Instance& instance : bench.instances()) {
+        bench.run("ga.load", instance, [&]() {
+            int n, m;
+            std::vector<std::pair<int, int>> edges;
+            readEdgeList(instance.path, n, m, edges);
+            Graph graph(n, m, edges, instance.name);
+            doNotOptimize(graph.nodes.data());
+        });
+
+        std::vector<std::pair<int, int>> edges = instance.edges;
+        Graph graph(instance.n, instance.m, edges, instance.name);
+        PRD prd(&graph, 1);
+
+        // The repair operators start from random labellings, like the initial population
+        std::mt19937 rng(instance.n);
+        std::uniform_int_distribution<> label(0, 2);
+        std::vector<Labelling> pool(16, Labelling(instance.n));
+        for (Labelling& labels : pool) {
+            for (Label& x : labels) x = label(rng);
+        }
+        size_t next = 0;
+        Solution* solution = new Solution(pool[0], &prd);
+
+        bench.run("prd.greedy_initialization", instance, [&]() {
+            Solution* greedy = prd.greedyInitialization();
+            doNotOptimize(greedy->fitness);
+            delete greedy;
+        });
+
+        bench.run("prd.grasp_initialization", instance, [&]() {
+            std::vector<Solution*> seeds = prd.graspInitialization(4, 0.3);
+            doNotOptimize(seeds.front()->fitness);
+            for (Solution* seed : seeds) delete seed;
+        });
+
+        bench.run("prd.fix_solution", instance,
+            [&]() { solution->solution = pool[next++ % pool.size()]; },
+            [&]() {
+                prd.fixSolution(solution);
+                doNotOptimize(solution->solution.data());
+            });
+
+        // A mutation of the last repaired individual, a few labels apart, which
+        // the repair engine handles around the changed vertices only
+        std::uniform_int_distribution<> vertex(0, instance.n - 1);
+        Labelling mutated;
+        prd.fixSolution(solution);
+        bench.run("prd.fix_solution_mutated", instance,
+            [&]() {
+                mutated = solution->solution;
+                for (int k = 0; k < std::max(1, instance.n / 100); k++) mutated[vertex(rng)] = label(rng);
+                solution->solution = mutated;
+            },
+            [&]() {
+                prd.fixSolution(solution);
+                doNotOptimize(solution->solution.data());
+            });
+
+        bench.run("solution.calculate_fitness", instance, [&]() {
+            doNotOptimize(solution->calculateFitness());
+        });
+
+        bench.run("prd.reduce_weight", instance,
+            [&]() { solution->solution = pool[next++ % pool.size()]; },
+            [&]() {
+                prd.reduceWeight(solution);
+                doNotOptimize(solution->solution.data());
+            });
+
+        delete solution;
+
+        // The repair on the graph relabelled by --order: the same labellings,
+        // with the neighbours of a vertex at nearby ids
+        const Adjacency adj = buildAdjacency(instance.n, instance.edges);
+        for (VertexOrder order : {VertexOrder::RCM, VertexOrder::DEGREE, VertexOrder::BFS}) {
+            const VertexOrdering ordering(adj, order);
+            std::vector<std::pair<int, int>> relabelledEdges = edgeList(ordering.graph());
+            Graph relabelled(instance.n, relabelledEdges.size(), relabelledEdges, instance.name);
+            PRD relabelledPrd(&relabelled, 1);
+            Solution* relabelledSolution = new Solution(pool[0], &relabelledPrd);
+
+            bench.run("prd.fix_solution." + vertexOrderName(order), instance,
+                [&]() { relabelledSolution->solution = pool[next++ % pool.size()]; },
+                [&]() {
+                    relabelledPrd.fixSolution(relabelledSolution);
+                    doNotOptimize(relabelledSolution->solution.data());
+                });
+
+            delete relabelledSolution;
+        }
+    }
+
+    bench.finish();
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include "PerfCheck.hpp"
+#include "../BRKGA/Graph.h"
+#include "../BRKGA/DecoderRoman.h"
+#include "../BRKGA/brkgaAPI/BRKGA.h"
+#include "../BRKGA/brkgaAPI/MTRand.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+// Throughput gate of the BRKGA. Every run evolves the populations for a fixed
+// number of generations with the default parameters of brkga-perfect-roman,
+// decoding on one thread so that the numbers do not depend on the machine load.
+const unsigned GENERATIONS = 200;
+const unsigned SEEDS[] = {1, 2};
+
+int main(int argc, char* argv[]) {
+    const PerfOptions options = parsePerfOptions(argc, argv);
+    PerfCheck check("brkga");
+
+    for (const std::string& path : perfInstances(options.base)) {
+        const std::string name = fs::path(path).stem().string();
+        const Graph graph(path);
+        const unsigned n = graph.getOrder();
+        const DecoderRoman decoder(graph);
+
+        const double pe = 0.20;
+        const unsigned populationSize = std::max(n / 100, static_cast<unsigned>(std::ceil(1.0 / pe)) + 1);
+
+        for (unsigned seed : SEEDS) {
+            for (int repetition = 0; repetition < options.repetitions; repetition++) {
+                MTRand rng((seed + 1) * 1234);
+                BRKGA<DecoderRoman, MTRand> algorithm(n, populationSize, pe, 0.10, 0.70, decoder, rng, 2, 1);
+
+                const auto begin = std::chrono::steady_clock::now();
+                for (unsigned generation = 1; generation <= GENERATIONS; generation++) {
+                    algorithm.evolve();
+                    if (generation % 100 == 0) algorithm.exchangeElite(2);
+                }
+                const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+                // The elite is carried over, every other chromosome is decoded
+                const double decodes = static_cast<double>(GENERATIONS) * algorithm.getK()
+                    * (algorithm.getP() - algorithm.getPe());
+                check.add("BRKGA", name, "generations_per_second", GENERATIONS / elapsed);
+                check.add("BRKGA", name, "decodes_per_second", decodes / elapsed);
+                check.addFitness("BRKGA", name, seed, static_cast<int>(algorithm.getBestFitness()));
+            }
+        }
+    }
+
+    if (!options.output.empty()) {
+        check.print();
+        check.write(options.output);
+    }
+    if (!options.baseline.empty()) {
+        return check.compare(options.baseline, options.tolerance) ? 0 : 1;
+    }
+    if (options.output.empty()) check.print();
+    return 0;
+}
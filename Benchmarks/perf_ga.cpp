@@ -0,0 +1,52 @@
+#include "PerfCheck.hpp"
+#include "../GA-CPP/GA.hpp"
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+// Throughput gate of the GA-CPP search. Every run evolves the population for
+// a fixed number of generations with the default parameters of GA-CPP; the
+// stagnation limit and the lower bound are taken out so that a faster
+// convergence does not shorten the run.
+const int GENERATIONS = 50;
+const int SEEDS[] = {1, 2};
+
+int main(int argc, char* argv[]) {
+    const PerfOptions options = parsePerfOptions(argc, argv);
+    PerfCheck check("ga");
+
+    for (const std::string& path : perfInstances(options.base)) {
+        const std::string name = fs::path(path).stem().string();
+        int n, m;
+        std::vector<std::pair<int, int>> edges;
+        readEdgeList(path, n, m, edges);
+
+        for (int seed : SEEDS) {
+            for (int repetition = 0; repetition < options.repetitions; repetition++) {
+                Graph graph(n, m, edges, name);
+                GeneticAlgorithm GA(&graph, 3, 5, GENERATIONS + 1, 0.1, 0.1, GENERATIONS, seed);
+                GA.prd->repairs = 0;
+
+                const auto begin = std::chrono::steady_clock::now();
+                const Result result = GA.gaFlow();
+                const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+                check.add("GA", name, "generations_per_second", GENERATIONS / elapsed);
+                check.add("GA", name, "repairs_per_second", GA.prd->repairs / elapsed);
+                check.addFitness("GA", name, seed, result.fitness);
+            }
+        }
+    }
+
+    if (!options.output.empty()) {
+        check.print();
+        check.write(options.output);
+    }
+    if (!options.baseline.empty()) {
+        return check.compare(options.baseline, options.tolerance) ? 0 : 1;
+    }
+    if (options.output.empty()) check.print();
+    return 0;
+}
@@ -0,0 +1,200 @@
+#include "Batch.hpp"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Calls of a forkJoin that the idle workers can take
+struct ForkGroup {
+    const std::function<void(int)>* body;
+    int count;
+    std::atomic<int> next{0};
+    std::atomic<int> done{0};
+};
+
+// Shared state of a running WorkStealingPool
+struct PoolState {
+    std::mutex groupsMutex;
+    std::vector<ForkGroup*> groups;
+    std::atomic<int> running{0};    // jobs taken and not finished
+
+    // Runs one call of some fork group; false if there was none
+    bool help() {
+        ForkGroup* group = nullptr;
+        int index = 0;
+        {
+            std::lock_guard<std::mutex> lock(this->groupsMutex);
+            for (ForkGroup* g : this->groups) {
+                if (g->next.load() >= g->count) continue;
+                index = g->next.fetch_add(1);
+                if (index < g->count) {
+                    group = g;
+                    break;
+                }
+            }
+        }
+        if (group == nullptr) return false;
+        (*group->body)(index);
+        group->done.fetch_add(1);
+        return true;
+    }
+};
+
+thread_local PoolState* currentPool = nullptr;
+
+}
+
+std::vector<std::string> batchInstances(const std::string& source) {
+    std::vector<std::string> paths;
+
+    if (fs::is_directory(source)) {
+        for (const auto& entry : fs::recursive_directory_iterator(source)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".txt") {
+                paths.push_back(entry.path().string());
+            }
+        }
+        std::sort(paths.begin(), paths.end());
+    } else {
+        std::ifstream file(source);
+        if (!file.is_open()) {
+            throw std::runtime_error("Error opening file: " + source);
+        }
+        const fs::path directory = fs::path(source).parent_path();
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream words(line);
+            std::string instance;
+            if (!(words >> instance) || instance[0] == '#') continue;
+            paths.push_back(fs::path(instance).is_absolute() ? instance : (directory / instance).string());
+        }
+    }
+
+    if (paths.empty()) {
+        throw std::runtime_error("No instances in " + source);
+    }
+    return paths;
+}
+
+double jobCost(int n, int m, int generations) {
+    return static_cast<double>(generations) * n * (static_cast<double>(n) + m);
+}
+
+bool readGraphHeader(const std::string& path, int& n, int& m) {
+    std::ifstream file(path);
+    return static_cast<bool>(file >> n >> m);
+}
+
+WorkStealingPool::WorkStealingPool(int threads) {
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    this->threads = threads;
+}
+
+void WorkStealingPool::run(std::vector<std::function<void()>> jobs) {
+    std::vector<Queue> queues(this->threads);
+    for (size_t i = 0; i < jobs.size(); i++) {
+        queues[i % this->threads].jobs.push_back(std::move(jobs[i]));
+    }
+    PoolState state;
+
+    // A job is counted as running before it leaves its queue, so a worker
+    // that sees no queued and no running job knows that nothing can fork
+    auto take = [&](int worker, std::function<void()>& job) {
+        for (int k = 0; k < this->threads; k++) {
+            Queue& queue = queues[(worker + k) % this->threads];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.jobs.empty()) {
+                state.running.fetch_add(1);
+                job = std::move(queue.jobs.front());
+                queue.jobs.pop_front();
+                return true;
+            }
+        }
+        return false;
+    };
+
+    std::vector<std::thread> workers;
+    for (int worker = 0; worker < this->threads; worker++) {
+        workers.emplace_back([&, worker]() {
+            currentPool = &state;
+            std::function<void()> job;
+            while (true) {
+                if (take(worker, job)) {
+                    job();
+                    state.running.fetch_sub(1);
+                } else if (!state.help()) {
+                    if (state.running.load() == 0) break;
+                    // Idle until a running job forks or finishes
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+            }
+            currentPool = nullptr;
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+}
+
+void forkJoin(int count, const std::function<void(int)>& body) {
+    PoolState* pool = currentPool;
+    if (pool == nullptr || count <= 1) {
+        for (int i = 0; i < count; i++) body(i);
+        return;
+    }
+
+    ForkGroup group;
+    group.body = &body;
+    group.count = count;
+    {
+        std::lock_guard<std::mutex> lock(pool->groupsMutex);
+        pool->groups.push_back(&group);
+    }
+
+    // The caller works through the calls too and is usually done first
+    int index;
+    while ((index = group.next.fetch_add(1)) < count) {
+        body(index);
+        group.done.fetch_add(1);
+    }
+    {
+        std::lock_guard<std::mutex> lock(pool->groupsMutex);
+        pool->groups.erase(std::find(pool->groups.begin(), pool->groups.end(), &group));
+    }
+    while (group.done.load() < count) std::this_thread::yield();
+}
+
+bool onPoolWorker() {
+    return currentPool != nullptr;
+}
+
+BatchWriter::BatchWriter(const std::string& path, size_t capacity) : file(path, std::ios::app), capacity(capacity) {
+    if (!this->file.is_open()) {
+        throw std::runtime_error("Error opening file: " + path);
+    }
+    this->buffer.reserve(capacity);
+}
+
+BatchWriter::~BatchWriter() {
+    this->flush();
+}
+
+void BatchWriter::write(const std::string& row) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->buffer += row;
+    if (this->buffer.size() >= this->capacity) this->flushLocked();
+}
+
+void BatchWriter::flush() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->flushLocked();
+}
+
+void BatchWriter::flushLocked() {
+    this->file << this->buffer;
+    this->file.flush();
+    this->buffer.clear();
+}
@@ -0,0 +1,186 @@
+#ifndef BATCH_HPP
+#define BATCH_HPP
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Batch mode: one process solves many graphs, with several trials each, in
+// place of a shell loop that starts a process per graph and trial. The
+// instance x trial jobs run on a work-stealing pool, largest estimated cost
+// first; the graphs are read and preprocessed in the background a few
+// instances ahead of the solvers, and every result goes through one buffered
+// CSV writer.
+
+// Graph files of a batch. 'source' is a directory, searched recursively for
+// .txt files, or a list file with one instance per line, as the IRACE
+// instances-list.txt files: the first word of every line that is not blank
+// or a # comment, relative to the directory of the list.
+std::vector<std::string> batchInstances(const std::string& source);
+
+// Relative cost of a run of 'generations' generations on a graph with n
+// vertices and m edges. Both metaheuristics keep a population proportional
+// to n and spend O(n + m) on every new individual, so a generation costs
+// about n (n + m). Only the order of the costs matters.
+double jobCost(int n, int m, int generations);
+
+// Order and size of a graph file, from its first line; false if unreadable
+bool readGraphHeader(const std::string& path, int& n, int& m);
+
+// Fixed set of workers, each with its own queue of jobs. Job i starts in the
+// queue of worker i % size(); a worker whose queue is empty takes jobs from
+// the other queues, and a worker with nothing left to take helps the running
+// jobs that called forkJoin. All of them take from the front, so the jobs
+// start in about the order they were given: largest first, and in the order
+// the graphs are prefetched in.
+class WorkStealingPool {
+    public:
+        // 0 threads: one per hardware thread
+        explicit WorkStealingPool(int threads = 0);
+
+        int size() const { return this->threads; }
+
+        // Runs every job and returns once all of them have finished
+        void run(std::vector<std::function<void()>> jobs);
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> jobs;
+        };
+
+        int threads;
+};
+
+// Runs body(0), ..., body(count - 1) and returns when all have finished. On a
+// worker of a WorkStealingPool the calls are shared with the workers that
+// have run out of jobs, which splits a long job at the end of a batch;
+// anywhere else they run in order on the calling thread. 'body' must be
+// thread-safe for distinct indices.
+void forkJoin(int count, const std::function<void(int)>& body);
+
+// True on a worker thread of a WorkStealingPool
+bool onPoolWorker();
+
+// Loads graphs on background threads, 'window' instances ahead of the latest
+// one asked for, and keeps each until it is released.
+template <typename T>
+class Prefetcher {
+    public:
+        using Loader = std::function<std::unique_ptr<T>(const std::string& path)>;
+
+        Prefetcher(const std::vector<std::string>& paths, Loader loader, int window = 2)
+            : paths(paths), loader(std::move(loader)), window(window), loads(paths.size()), released(paths.size(), false) {}
+
+        // Instance i, waiting for it if it is still loading. Rethrows the
+        // exception of a failed load.
+        std::shared_ptr<const T> get(int i) {
+            std::shared_future<std::shared_ptr<const T>> load;
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                const int last = std::min<int>(i + this->window, this->paths.size() - 1);
+                for (int j = i; j <= last; j++) {
+                    if (!this->loads[j].valid() && !this->released[j]) this->start(j);
+                }
+                load = this->loads[i];
+            }
+            return load.get();
+        }
+
+        // Frees instance i; jobs still running on it keep their copy
+        void release(int i) {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->loads[i] = std::shared_future<std::shared_ptr<const T>>();
+            this->released[i] = true;
+        }
+
+    private:
+        std::vector<std::string> paths;
+        Loader loader;
+        int window;
+        std::mutex mutex;
+        std::vector<std::shared_future<std::shared_ptr<const T>>> loads;
+        std::vector<bool> released;
+
+        void start(int i) {
+            const std::string path = this->paths[i];
+            Loader& load = this->loader;
+            this->loads[i] = std::async(std::launch::async, [path, &load]() {
+                return std::shared_ptr<const T>(load(path));
+            }).share();
+        }
+};
+
+// CSV rows from concurrent jobs, kept in memory and appended to the file in
+// blocks of about 'capacity' bytes, and when the writer is destroyed.
+class BatchWriter {
+    public:
+        explicit BatchWriter(const std::string& path, size_t capacity = 1 << 16);
+        ~BatchWriter();
+
+        void write(const std::string& row);
+        void flush();
+
+    private:
+        std::mutex mutex;
+        std::ofstream file;
+        std::string buffer;
+        size_t capacity;
+
+        void flushLocked();
+};
+
+// Runs 'trials' trials of every instance on 'workers' threads (0: one per
+// hardware thread), the instances of the largest jobCost for 'generations'
+// first. 'load' builds what the trials of a graph share and runs in the
+// background; 'solve' runs one trial and must be thread-safe. A graph that
+// fails to load or solve is reported and skipped.
+template <typename T>
+void runBatch(std::vector<std::string> paths, int trials, int workers, int generations,
+    typename Prefetcher<T>::Loader load,
+    const std::function<void(const T& instance, const std::string& path, int trial)>& solve) {
+
+    // Longest processing time first: the big graphs start early and the
+    // small ones fill the gaps at the end
+    std::vector<std::pair<double, std::string>> costs;
+    for (const std::string& path : paths) {
+        int n = 0, m = 0;
+        readGraphHeader(path, n, m);
+        costs.push_back({jobCost(n, m, generations), path});
+    }
+    std::stable_sort(costs.begin(), costs.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+    for (size_t i = 0; i < costs.size(); i++) paths[i] = costs[i].second;
+
+    Prefetcher<T> prefetcher(paths, std::move(load));
+    std::vector<int> remaining(paths.size(), trials);
+    std::mutex remainingMutex;
+    std::mutex errorMutex;
+
+    std::vector<std::function<void()>> jobs;
+    for (size_t i = 0; i < paths.size(); i++) {
+        for (int trial = 0; trial < trials; trial++) {
+            jobs.push_back([&, i, trial]() {
+                try {
+                    std::shared_ptr<const T> instance = prefetcher.get(i);
+                    solve(*instance, paths[i], trial);
+                } catch (const std::exception& e) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    std::cerr << "Skipping " << paths[i] << " (trial " << trial << "): " << e.what() << std::endl;
+                }
+
+                std::lock_guard<std::mutex> lock(remainingMutex);
+                if (--remaining[i] == 0) prefetcher.release(i);
+            });
+        }
+    }
+
+    WorkStealingPool(workers).run(std::move(jobs));
+}
+
+#endif
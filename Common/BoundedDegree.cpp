@@ -0,0 +1,15 @@
+#include "BoundedDegree.hpp"
+#include <algorithm>
+
+int maxDegree(const Adjacency& adj) {
+    size_t degree = 0;
+    for (const std::vector<int>& neighbours : adj) degree = std::max(degree, neighbours.size());
+    return degree;
+}
+
+BoundedAdjacency boundedAdjacency(const Adjacency& adj) {
+    const int degree = maxDegree(adj);
+    if (degree <= 3) return FixedDegreeAdjacency<3>(adj);
+    if (degree <= 6) return FixedDegreeAdjacency<6>(adj);
+    return std::monostate();
+}
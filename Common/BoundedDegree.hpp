@@ -0,0 +1,56 @@
+#ifndef BOUNDED_DEGREE_HPP
+#define BOUNDED_DEGREE_HPP
+#include "RomanGraph.hpp"
+#include <algorithm>
+#include <array>
+#include <variant>
+
+// Adjacency of a graph whose degrees are at most D, for kernels compiled for
+// that bound. Every vertex has a row of D slots in one flat array: its
+// neighbours, then the sentinel vertex order() in the slots left over. Loops
+// over a whole row have D iterations known at compile time, which the
+// compiler unrolls into straight-line code; kernels that give the sentinel a
+// state no rule fires on, or read some neutral vertex in its place, run them
+// with no test on the degree at all. Whole campaigns run on cubic graphs and on
+// meshes of degree at most 6, the two bounds below.
+template <int D>
+class FixedDegreeAdjacency {
+    public:
+        static constexpr int MAX_DEGREE = D;
+
+        // 'adj' has no degree above D
+        explicit FixedDegreeAdjacency(const Adjacency& adj) : rows(adj.size()) {
+            const int n = adj.size();
+            for (int u = 0; u < n; u++) {
+                this->rows[u].fill(n);
+                std::copy(adj[u].begin(), adj[u].end(), this->rows[u].begin());
+            }
+        }
+
+        size_t size() const { return this->rows.size(); }
+        int order() const { return this->rows.size(); }
+
+        // All D slots of u, the unused ones holding order()
+        const std::array<int, D>& row(int u) const { return this->rows[u]; }
+
+    private:
+        std::vector<std::array<int, D>> rows;
+};
+
+// The smallest fixed-degree form that fits a graph, or none (monostate)
+using BoundedAdjacency = std::variant<std::monostate, FixedDegreeAdjacency<3>, FixedDegreeAdjacency<6>>;
+
+int maxDegree(const Adjacency& adj);
+
+BoundedAdjacency boundedAdjacency(const Adjacency& adj);
+
+// body(graph) on the FixedDegreeAdjacency held by 'bounded', or on 'adj' when
+// there is none; the calls for every graph type return the same type
+template <class Body>
+decltype(auto) withBoundedDegree(const BoundedAdjacency& bounded, const Adjacency& adj, Body&& body) {
+    if (const auto* graph = std::get_if<FixedDegreeAdjacency<3>>(&bounded)) return body(*graph);
+    if (const auto* graph = std::get_if<FixedDegreeAdjacency<6>>(&bounded)) return body(*graph);
+    return body(adj);
+}
+
+#endif
@@ -0,0 +1,75 @@
+#include "Server.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Thin target runner for irace: hands the evaluation to the solver daemon at
+// solverSocket() and prints its fitness, and also its time when
+// $PRD_CLIENT_TIME is set, for scenarios with a time budget.
+//     prd-client <configuration id> <instance id> <seed> <instance> [options]
+//     prd-client shutdown
+int main(int argc, char* argv[]) {
+    std::string request;
+    if (argc == 2 && std::string(argv[1]) == "shutdown") {
+        request = "shutdown\n";
+    } else if (argc >= 5) {
+        // The daemon resolves the instance against its own working directory
+        request = std::string("c") + argv[1] + "-" + argv[2] + "-" + argv[3] + " " + argv[3]
+            + " " + std::filesystem::absolute(argv[4]).string();
+        for (int i = 5; i < argc; i++) request += std::string(" ") + argv[i];
+        request += "\n";
+    } else {
+        std::cerr << "Usage: " << argv[0] << " <configuration_id> <instance_id> <seed> <instance> [options]\n"
+                  << "       " << argv[0] << " shutdown" << std::endl;
+        return 1;
+    }
+
+    const std::string path = solverSocket();
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        std::cerr << "Error connecting to the solver daemon at " << path << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    if (send(fd, request.data(), request.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(request.size())) {
+        std::cerr << "Error sending the request: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    if (request == "shutdown\n") {
+        close(fd);
+        return 0;
+    }
+
+    std::string response;
+    char buffer[512];
+    ssize_t n;
+    while (response.find('\n') == std::string::npos && (n = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        response.append(buffer, n);
+    }
+    close(fd);
+
+    std::istringstream words(response);
+    std::string id, fitness, time;
+    words >> id >> fitness;
+    if (fitness.empty() || fitness == "error") {
+        std::string message;
+        std::getline(words, message);
+        std::cerr << "Evaluation failed:" << message << std::endl;
+        return 1;
+    }
+    words >> time;
+
+    std::cout << fitness;
+    if (std::getenv("PRD_CLIENT_TIME") != nullptr) std::cout << " " << time;
+    std::cout << std::endl;
+    return 0;
+}
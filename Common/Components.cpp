@@ -0,0 +1,113 @@
+#include "Components.hpp"
+#include "TreeDecomposition.hpp"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+ComponentDecomposition::ComponentDecomposition(const Adjacency& adj) : n(adj.size()) {
+    this->components = connectedComponents(adj);
+    this->subgraphs.reserve(this->components.size());
+    for (const std::vector<int>& component : this->components) {
+        this->subgraphs.push_back(inducedSubgraph(adj, component));
+    }
+}
+
+std::vector<int> ComponentDecomposition::stitch(const std::vector<std::vector<int>>& labels) const {
+    if (labels.size() != this->components.size()) {
+        throw std::invalid_argument("stitch: expected one labelling per component.");
+    }
+    std::vector<int> result(this->n, -1);
+    for (size_t i = 0; i < this->components.size(); i++) {
+        if (labels[i].size() != this->components[i].size()) {
+            throw std::invalid_argument("stitch: labelling does not match its component.");
+        }
+        for (size_t j = 0; j < labels[i].size(); j++) {
+            result[this->components[i][j]] = labels[i][j];
+        }
+    }
+    return result;
+}
+
+void ComponentStats::print(std::ostream& os) const {
+    os << "Components: " << (this->isolated + this->trivial + this->exact + this->heuristic)
+       << " (isolated " << this->isolated
+       << ", trivial " << this->trivial
+       << ", exact " << this->exact
+       << ", heuristic " << this->heuristic << ")" << std::endl;
+}
+
+std::vector<int> solveByComponents(const ComponentDecomposition& decomposition,
+    const ComponentSolver& heuristic, int threads, ComponentStats* stats) {
+
+    const int count = decomposition.size();
+    std::vector<std::vector<int>> labels(count);
+    std::vector<char> kind(count, 0);
+
+    // Largest first, so that a big component does not start last
+    std::vector<int> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return decomposition.vertices(a).size() > decomposition.vertices(b).size();
+    });
+
+    #ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 1) num_threads(std::max(threads, 1))
+    #endif
+    for (int k = 0; k < count; k++) {
+        const int i = order[k];
+        const Adjacency& sub = decomposition.subgraph(i);
+        const int size = sub.size();
+
+        if (size == 1) {
+            labels[i] = {1};
+            kind[i] = 0;
+            continue;
+        }
+
+        int universal = -1;
+        for (int u = 0; u < size && universal == -1; u++) {
+            if (static_cast<int>(sub[u].size()) == size - 1) universal = u;
+        }
+        if (universal != -1) {
+            labels[i].assign(size, 0);
+            labels[i][universal] = 2;
+            kind[i] = 1;
+        } else if (size <= EXACT_LIMIT) {
+            ExactSolver solver(sub);
+            if (solver.solve(EXACT_TIME_LIMIT)) {
+                labels[i] = solver.labels();
+                kind[i] = 2;
+            } else {
+                std::vector<int> candidate = heuristic(sub, i);
+                labels[i] = labelWeight(candidate) < solver.weight() ? candidate : solver.labels();
+                kind[i] = 3;
+            }
+        } else {
+            TreeDecomposition treeDecomposition(sub);
+            if (treeDecomposition.isTractable()) {
+                labels[i] = treeDecomposition.solve();
+                kind[i] = 2;
+            } else {
+                labels[i] = heuristic(sub, i);
+                kind[i] = 3;
+            }
+        }
+    }
+
+    if (stats != nullptr) {
+        *stats = ComponentStats();
+        for (int i = 0; i < count; i++) {
+            switch (kind[i]) {
+                case 0: stats->isolated++; break;
+                case 1: stats->trivial++; break;
+                case 2: stats->exact++; break;
+                default: stats->heuristic++; break;
+            }
+        }
+    }
+
+    return decomposition.stitch(labels);
+}
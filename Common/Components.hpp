@@ -0,0 +1,57 @@
+#ifndef COMPONENTS_HPP
+#define COMPONENTS_HPP
+#include "RomanGraph.hpp"
+#include "ExactSolver.hpp"
+#include <functional>
+#include <iostream>
+
+// The weight of a perfect Roman dominating function is the sum of the weights
+// of its restrictions to the connected components, so each component can be
+// solved on its own and the labellings stitched back together.
+class ComponentDecomposition {
+    public:
+        explicit ComponentDecomposition(const Adjacency& adj);
+        ~ComponentDecomposition() = default;
+
+        int size() const { return this->components.size(); }
+        int order() const { return this->n; }
+
+        // Original vertices of component i; vertex vertices(i)[j] is j in subgraph(i)
+        const std::vector<int>& vertices(int i) const { return this->components[i]; }
+        const Adjacency& subgraph(int i) const { return this->subgraphs[i]; }
+
+        // Builds the labelling of the whole graph from one labelling per component
+        std::vector<int> stitch(const std::vector<std::vector<int>>& labels) const;
+
+    private:
+        int n;
+        std::vector<std::vector<int>> components;
+        std::vector<Adjacency> subgraphs;
+};
+
+struct ComponentStats {
+    int isolated = 0;
+    int trivial = 0;    // a universal vertex: weight 2
+    int exact = 0;      // solved to optimality by the exact solver
+    int heuristic = 0;  // handed to the metaheuristic
+
+    void print(std::ostream& os) const;
+};
+
+// Solver for the components that are too large to be solved exactly. It gets
+// the component subgraph and its index, and must be thread-safe.
+using ComponentSolver = std::function<std::vector<int>(const Adjacency& component, int index)>;
+
+// Solves every component with a method that fits its size: isolated and
+// universal-vertex components directly, components with at most EXACT_LIMIT
+// vertices with the exact solver, the others with 'heuristic'. An exact run
+// that hits EXACT_TIME_LIMIT falls back to the heuristic and keeps the better
+// labelling. Larger components of small treewidth are solved exactly by the
+// TreeDecomposition DP. Components run concurrently on 'threads' threads,
+// largest first.
+constexpr int EXACT_LIMIT = 40;
+constexpr double EXACT_TIME_LIMIT = 1.0;
+std::vector<int> solveByComponents(const ComponentDecomposition& decomposition,
+    const ComponentSolver& heuristic, int threads, ComponentStats* stats = nullptr);
+
+#endif
@@ -0,0 +1,206 @@
+#include "DenseGraph.hpp"
+#include <algorithm>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define DENSE_AVX2 1
+#endif
+
+namespace {
+
+// Portable kernels over 'words' words of a and b
+int popcountAndScalar(const uint64_t* a, const uint64_t* b, int words) {
+    int count = 0;
+    for (int i = 0; i < words; i++) count += __builtin_popcountll(a[i] & b[i]);
+    return count;
+}
+
+bool anyAndScalar(const uint64_t* a, const uint64_t* b, int words) {
+    for (int i = 0; i < words; i++) {
+        if (a[i] & b[i]) return true;
+    }
+    return false;
+}
+
+#ifdef DENSE_AVX2
+
+// Popcount of four words at once by nibble lookup (Mula, Kurz and Lemire,
+// 2018); 'words' is a multiple of 4, as VertexSet::wordsFor makes it
+__attribute__((target("avx2")))
+int popcountAndAvx2(const uint64_t* a, const uint64_t* b, int words) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    __m256i total = _mm256_setzero_si256();
+    for (int i = 0; i < words; i += 4) {
+        const __m256i v = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                                           _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+        const __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low)),
+                                               _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low)));
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+    }
+    return _mm256_extract_epi64(total, 0) + _mm256_extract_epi64(total, 1) +
+           _mm256_extract_epi64(total, 2) + _mm256_extract_epi64(total, 3);
+}
+
+__attribute__((target("avx2")))
+bool anyAndAvx2(const uint64_t* a, const uint64_t* b, int words) {
+    for (int i = 0; i < words; i += 4) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        if (!_mm256_testz_si256(x, y)) return true;
+    }
+    return false;
+}
+
+#endif
+
+// Bit-sliced decrement of the counters selected by 'mask': the borrow ripples
+// up the planes, and stops once no lane borrows any more
+inline __attribute__((always_inline))
+void decrementSlicedBody(uint64_t* bits, int planes, int words, const uint64_t* mask, uint64_t* borrow) {
+    for (int i = 0; i < words; i++) borrow[i] = mask[i];
+    for (int p = 0; p < planes; p++) {
+        uint64_t* plane = bits + static_cast<size_t>(p) * words;
+        uint64_t left = 0;
+        for (int i = 0; i < words; i++) {
+            const uint64_t was = plane[i];
+            plane[i] = was ^ borrow[i];
+            borrow[i] &= ~was;
+            left |= borrow[i];
+        }
+        if (!left) break;
+    }
+}
+
+// Some lane of a & s has counter 1: bit 0 set, every other plane clear
+inline __attribute__((always_inline))
+bool anyOneSlicedBody(const uint64_t* bits, int planes, int words, const uint64_t* a, const uint64_t* s, uint64_t* lanes) {
+    uint64_t left = 0;
+    for (int i = 0; i < words; i++) {
+        lanes[i] = a[i] & s[i] & bits[i];
+        left |= lanes[i];
+    }
+    for (int p = 1; p < planes && left; p++) {
+        const uint64_t* plane = bits + static_cast<size_t>(p) * words;
+        left = 0;
+        for (int i = 0; i < words; i++) {
+            lanes[i] &= ~plane[i];
+            left |= lanes[i];
+        }
+    }
+    return left != 0;
+}
+
+void decrementSlicedScalar(uint64_t* bits, int planes, int words, const uint64_t* mask, uint64_t* borrow) {
+    decrementSlicedBody(bits, planes, words, mask, borrow);
+}
+
+bool anyOneSlicedScalar(const uint64_t* bits, int planes, int words, const uint64_t* a, const uint64_t* s, uint64_t* lanes) {
+    return anyOneSlicedBody(bits, planes, words, a, s, lanes);
+}
+
+#ifdef DENSE_AVX2
+
+// The same loops, vectorised by the compiler for AVX2
+__attribute__((target("avx2")))
+void decrementSlicedAvx2(uint64_t* bits, int planes, int words, const uint64_t* mask, uint64_t* borrow) {
+    decrementSlicedBody(bits, planes, words, mask, borrow);
+}
+
+__attribute__((target("avx2")))
+bool anyOneSlicedAvx2(const uint64_t* bits, int planes, int words, const uint64_t* a, const uint64_t* s, uint64_t* lanes) {
+    return anyOneSlicedBody(bits, planes, words, a, s, lanes);
+}
+
+#endif
+
+struct Kernels {
+    int (*popcountAnd)(const uint64_t*, const uint64_t*, int) = popcountAndScalar;
+    bool (*anyAnd)(const uint64_t*, const uint64_t*, int) = anyAndScalar;
+    void (*decrementSliced)(uint64_t*, int, int, const uint64_t*, uint64_t*) = decrementSlicedScalar;
+    bool (*anyOneSliced)(const uint64_t*, int, int, const uint64_t*, const uint64_t*, uint64_t*) = anyOneSlicedScalar;
+
+    Kernels() {
+#ifdef DENSE_AVX2
+        if (__builtin_cpu_supports("avx2")) {
+            this->popcountAnd = popcountAndAvx2;
+            this->anyAnd = anyAndAvx2;
+            this->decrementSliced = decrementSlicedAvx2;
+            this->anyOneSliced = anyOneSlicedAvx2;
+        }
+#endif
+    }
+};
+
+const Kernels kernels;
+
+}
+
+DenseAdjacency::DenseAdjacency(const Adjacency& adj)
+    : n(adj.size()), words(VertexSet::wordsFor(adj.size())), rows(static_cast<size_t>(n) * words, 0) {
+    for (int u = 0; u < this->n; u++) {
+        uint64_t* row = this->rows.data() + static_cast<size_t>(u) * this->words;
+        for (int v : adj[u]) row[v >> 6] |= uint64_t(1) << (v & 63);
+    }
+}
+
+int DenseAdjacency::countIn(int u, const VertexSet& s) const {
+    return kernels.popcountAnd(this->row(u), s.data(), this->words);
+}
+
+bool DenseAdjacency::intersects(int u, const VertexSet& s) const {
+    return kernels.anyAnd(this->row(u), s.data(), this->words);
+}
+
+bool DenseAdjacency::isPerfectRoman(const Labelling& labels) const {
+    if (static_cast<int>(labels.size()) != this->n) return false;
+    VertexSet twos(this->n);
+    for (int v = 0; v < this->n; v++) {
+        if (labels[v] > 2) return false;
+        if (labels[v] == 2) twos.set(v);
+    }
+    for (int u = 0; u < this->n; u++) {
+        if (labels[u] == 0 && this->countIn(u, twos) != 1) return false;
+    }
+    return true;
+}
+
+SlicedCounters::SlicedCounters(const DenseAdjacency& adj, const std::vector<int>& values)
+    : adj(adj), words(VertexSet::wordsFor(adj.order())), planes(1) {
+    const int largest = values.empty() ? 0 : *std::max_element(values.begin(), values.end());
+    while ((largest >> this->planes) != 0) this->planes++;
+    this->bits.assign(static_cast<size_t>(this->planes) * this->words, 0);
+    this->scratch.assign(this->words, 0);
+    for (int v = 0; v < static_cast<int>(values.size()); v++) {
+        for (int p = 0; p < this->planes; p++) {
+            this->bits[static_cast<size_t>(p) * this->words + (v >> 6)] |= uint64_t((values[v] >> p) & 1) << (v & 63);
+        }
+    }
+}
+
+int SlicedCounters::value(int v) const {
+    int value = 0;
+    for (int p = 0; p < this->planes; p++) {
+        value |= static_cast<int>((this->bits[static_cast<size_t>(p) * this->words + (v >> 6)] >> (v & 63)) & 1) << p;
+    }
+    return value;
+}
+
+void SlicedCounters::decrementNeighbours(int u) {
+    kernels.decrementSliced(this->bits.data(), this->planes, this->words, this->adj.row(u), this->scratch.data());
+}
+
+bool SlicedCounters::anyOneAround(int u, const VertexSet& s) const {
+    return kernels.anyOneSliced(this->bits.data(), this->planes, this->words, this->adj.row(u), s.data(), this->scratch.data());
+}
+
+double density(const Adjacency& adj) {
+    const double n = adj.size();
+    return n < 2 ? 0.0 : 2.0 * countEdges(adj) / (n * (n - 1));
+}
+
+std::unique_ptr<DenseAdjacency> denseAdjacency(const Adjacency& adj) {
+    if (density(adj) < DENSE_THRESHOLD) return nullptr;
+    return std::unique_ptr<DenseAdjacency>(new DenseAdjacency(adj));
+}
@@ -0,0 +1,103 @@
+#ifndef DENSE_GRAPH_HPP
+#define DENSE_GRAPH_HPP
+#include "RomanGraph.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Bit-parallel kernels for dense graphs. Every row of the adjacency matrix is
+// a bitset, so questions about the neighbours of u that fall in some set of
+// vertices (the 2s, the dominated 0s) cost n / 64 word operations instead of
+// deg(u) scattered reads: a win once the degrees are a few percent of n, as
+// in many DIMACS graphs. The words are processed four at a time with AVX2
+// when the processor has it, checked at run time, and one at a time
+// otherwise. Sparse graphs keep the adjacency lists; denseAdjacency decides.
+
+// Density 2m / (n (n - 1)) from which the bitsets are used
+constexpr double DENSE_THRESHOLD = 0.06;
+
+// Set of vertices of a graph with n vertices, as bits
+class VertexSet {
+    public:
+        VertexSet() = default;
+        explicit VertexSet(int n) : bits(wordsFor(n), 0) {}
+
+        bool test(int v) const { return (this->bits[v >> 6] >> (v & 63)) & 1; }
+        void set(int v) { this->bits[v >> 6] |= uint64_t(1) << (v & 63); }
+        void reset(int v) { this->bits[v >> 6] &= ~(uint64_t(1) << (v & 63)); }
+        // Without a branch, for values that follow no pattern
+        void set(int v, bool value) {
+            const uint64_t bit = uint64_t(1) << (v & 63);
+            uint64_t& word = this->bits[v >> 6];
+            word = (word & ~bit) | (-uint64_t(value) & bit);
+        }
+
+        const uint64_t* data() const { return this->bits.data(); }
+        uint64_t* data() { return this->bits.data(); }
+        int words() const { return this->bits.size(); }
+
+        // Words for n vertices, rounded up to whole AVX2 registers
+        static int wordsFor(int n) { return (n + 255) / 256 * 4; }
+
+    private:
+        std::vector<uint64_t> bits;
+};
+
+class DenseAdjacency {
+    public:
+        explicit DenseAdjacency(const Adjacency& adj);
+
+        int order() const { return this->n; }
+
+        // |N(u) & s|, e.g. the number of 2s around u
+        int countIn(int u, const VertexSet& s) const;
+
+        // N(u) & s is not empty, e.g. u has a dominated 0 neighbour
+        bool intersects(int u, const VertexSet& s) const;
+
+        // Every vertex with label 0 has exactly one neighbour with label 2,
+        // as isPerfectRoman
+        bool isPerfectRoman(const Labelling& labels) const;
+
+        // Row u of the matrix, VertexSet::wordsFor(order()) words
+        const uint64_t* row(int u) const { return this->rows.data() + static_cast<size_t>(u) * this->words; }
+
+    private:
+        int n;
+        int words;
+        std::vector<uint64_t> rows;     // n rows of 'words' words
+};
+
+// One small counter per vertex, e.g. its number of 2 neighbours, stored bit
+// sliced: plane p holds bit p of every counter. Decrementing the counters of
+// a whole neighbourhood then costs a few word operations per plane, where
+// the lists would update deg(u) counters one by one.
+class SlicedCounters {
+    public:
+        // Counters for adj.order() vertices, set to 'values' (>= 0)
+        SlicedCounters(const DenseAdjacency& adj, const std::vector<int>& values);
+
+        int value(int v) const;
+
+        // Decrements the counters of the neighbours of u, all positive
+        void decrementNeighbours(int u);
+
+        // Some neighbour of u in s has counter 1
+        bool anyOneAround(int u, const VertexSet& s) const;
+
+    private:
+        const DenseAdjacency& adj;
+        int words;
+        int planes;
+        std::vector<uint64_t> bits;             // 'planes' planes of 'words' words
+        mutable std::vector<uint64_t> scratch;  // borrows, or the candidates of anyOneAround
+};
+
+// Density of a graph
+double density(const Adjacency& adj);
+
+// The bitset adjacency of 'adj' when its density reaches DENSE_THRESHOLD,
+// nullptr otherwise
+std::unique_ptr<DenseAdjacency> denseAdjacency(const Adjacency& adj);
+
+#endif
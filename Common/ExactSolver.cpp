@@ -0,0 +1,273 @@
+#include "ExactSolver.hpp"
+#include "TreeDecomposition.hpp"
+#include <algorithm>
+#include <limits>
+
+ExactSolver::ExactSolver(const Adjacency& adj) : adj(adj) {}
+
+bool ExactSolver::solve(double timeLimit) {
+    auto begin = std::chrono::steady_clock::now();
+    this->deadline = begin + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(timeLimit));
+    this->timedOut = false;
+    this->nodes = 0;
+    this->optimal = true;
+    this->bestLabels.assign(this->adj.size(), -1);
+
+    for (const std::vector<int>& component : connectedComponents(this->adj)) {
+        std::vector<int> labels;
+        if (component.size() == 1) {
+            labels = {1};
+        } else {
+            bool proven = false;
+            labels = this->solveComponent(inducedSubgraph(this->adj, component), proven);
+            this->optimal = this->optimal && proven;
+        }
+        for (size_t i = 0; i < component.size(); i++) {
+            this->bestLabels[component[i]] = labels[i];
+        }
+    }
+
+    this->bestWeight = labelWeight(this->bestLabels);
+    this->elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return this->optimal;
+}
+
+std::vector<int> ExactSolver::solveComponent(const Adjacency& component, bool& proven) {
+    const int n = component.size();
+    if (n <= GRAY_CODE_LIMIT) {
+        proven = true;
+        return solveByGrayCode(component);
+    }
+
+    const double remaining = std::chrono::duration<double>(this->deadline - std::chrono::steady_clock::now()).count();
+    TreeDecomposition decomposition(component, TreeDecomposition::MAX_WIDTH, remaining);
+    if (decomposition.isTractable()) {
+        proven = true;
+        return decomposition.solve();
+    }
+
+    this->sub = component;
+    const int words = (n + 63) / 64;
+    this->neighborBits.assign(n, Bitset(words, 0));
+    for (int u = 0; u < n; u++) {
+        for (int v : this->sub[u]) this->neighborBits[u][v / 64] |= uint64_t(1) << (v % 64);
+    }
+    this->state.assign(n, UNDECIDED);
+    this->inCount.assign(n, 0);
+    this->openCount.resize(n);
+    for (int u = 0; u < n; u++) this->openCount[u] = this->sub[u].size();
+    this->undecided.assign(words, ~uint64_t(0));
+    if (n % 64 != 0) this->undecided.back() = (uint64_t(1) << (n % 64)) - 1;
+    this->cost = 0;
+
+    // The greedy labelling is the first incumbent
+    this->incumbentSet = this->greedySet();
+    this->incumbent = labelWeight(labelsFromTwos(this->sub, this->incumbentSet));
+
+    this->branch();
+
+    proven = !this->timedOut;
+    return labelsFromTwos(this->sub, this->incumbentSet);
+}
+
+std::vector<int> ExactSolver::solveByGrayCode(const Adjacency& component) {
+    const int n = component.size();
+    std::vector<int> count(n, 0);
+    std::vector<char> isTwo(n, false);
+
+    // With S empty every vertex costs 1
+    int cost = n;
+    int bestCost = cost;
+    unsigned set = 0;
+    unsigned bestSet = 0;
+
+    // Consecutive Gray codes differ in one vertex, so only its neighbourhood changes
+    for (unsigned k = 1; k < (1u << n); k++) {
+        const int w = __builtin_ctz(k);
+        const int step = isTwo[w] ? -1 : 1;
+        if (step == 1) {
+            cost += 2 - (count[w] != 1);
+        } else {
+            cost += (count[w] != 1) - 2;
+        }
+        isTwo[w] = !isTwo[w];
+        for (int v : component[w]) {
+            const int before = count[v];
+            count[v] += step;
+            if (!isTwo[v]) cost += (count[v] != 1) - (before != 1);
+        }
+        set ^= 1u << w;
+
+        if (cost < bestCost) {
+            bestCost = cost;
+            bestSet = set;
+        }
+    }
+
+    for (int u = 0; u < n; u++) {
+        isTwo[u] = (bestSet >> u) & 1u;
+    }
+    return labelsFromTwos(component, isTwo);
+}
+
+// Adds label-2 vertices while some vertex lowers the weight
+std::vector<char> ExactSolver::greedySet() const {
+    const int n = this->sub.size();
+    std::vector<int> count(n, 0);
+    std::vector<char> isTwo(n, false);
+
+    while (true) {
+        int best = -1;
+        int bestDelta = 0;
+        for (int w = 0; w < n; w++) {
+            if (isTwo[w]) continue;
+            int delta = 2 - (count[w] != 1);
+            for (int v : this->sub[w]) {
+                if (isTwo[v]) continue;
+                if (count[v] == 0) delta--;
+                else if (count[v] == 1) delta++;
+            }
+            if (delta < bestDelta) {
+                bestDelta = delta;
+                best = w;
+            }
+        }
+        if (best == -1) break;
+
+        isTwo[best] = true;
+        for (int v : this->sub[best]) count[v]++;
+    }
+    return isTwo;
+}
+
+void ExactSolver::branch() {
+    this->nodes++;
+    if ((this->nodes & 1023) == 0 && std::chrono::steady_clock::now() > this->deadline) {
+        this->timedOut = true;
+    }
+    if (this->timedOut) return;
+
+    int w = -1;
+    const double bound = this->lowerBound(w);
+    if (bound > this->incumbent - 1 + 1e-9) return;
+
+    // Nothing left to cover: every undecided vertex already has exactly one
+    // neighbour in S, so leaving them all out adds nothing
+    if (w == -1) {
+        this->incumbent = this->cost;
+        for (size_t u = 0; u < this->state.size(); u++) {
+            this->incumbentSet[u] = this->state[u] == IN;
+        }
+        return;
+    }
+
+    const int previousCost = this->cost;
+    this->setIn(w);
+    this->branch();
+    this->undoIn(w, previousCost);
+
+    this->setOut(w);
+    this->branch();
+    this->undoOut(w, previousCost);
+}
+
+// Every "needy" vertex costs 1 unless some undecided vertex in its reach enters
+// S. A vertex w entering S costs 2 and covers c(w) needy vertices, so each of
+// them can be charged min(1, 2 / c(w)) over its best coverer. Also picks the
+// undecided vertex that covers the most needy vertices as the next branch.
+double ExactSolver::lowerBound(int& branchVertex) const {
+    const int n = this->sub.size();
+    const int words = this->undecided.size();
+
+    // needy: undecided with a count other than 1, or out with no neighbour in S yet
+    // open: needy vertices that a neighbour entering S would still cover
+    std::vector<char> needy(n, false);
+    Bitset open(words, 0);
+    for (int v = 0; v < n; v++) {
+        if (this->state[v] == UNDECIDED) {
+            needy[v] = this->inCount[v] != 1;
+        } else if (this->state[v] == OUT) {
+            needy[v] = this->inCount[v] == 0 && this->openCount[v] > 0;
+        }
+        if (needy[v] && this->inCount[v] == 0) open[v / 64] |= uint64_t(1) << (v % 64);
+    }
+
+    const double INF = std::numeric_limits<double>::infinity();
+    std::vector<double> ratio(n, INF);
+    branchVertex = -1;
+    int bestCover = 0;
+    for (int i = 0; i < words; i++) {
+        uint64_t bits = this->undecided[i];
+        while (bits) {
+            const int w = i * 64 + __builtin_ctzll(bits);
+            bits &= bits - 1;
+
+            int cover = needy[w];
+            for (int j = 0; j < words; j++) {
+                cover += __builtin_popcountll(this->neighborBits[w][j] & open[j]);
+            }
+            if (cover > 0) ratio[w] = 2.0 / cover;
+            if (cover > bestCover) {
+                bestCover = cover;
+                branchVertex = w;
+            }
+        }
+    }
+
+    double bound = this->cost;
+    for (int v = 0; v < n; v++) {
+        if (!needy[v]) continue;
+        double share = 1.0;
+        if (this->state[v] == UNDECIDED) share = std::min(share, ratio[v]);
+        if (this->inCount[v] == 0) {
+            for (int u : this->sub[v]) {
+                if (this->state[u] == UNDECIDED) share = std::min(share, ratio[u]);
+            }
+        }
+        bound += share;
+    }
+    return bound;
+}
+
+void ExactSolver::setIn(int w) {
+    this->state[w] = IN;
+    this->undecided[w / 64] &= ~(uint64_t(1) << (w % 64));
+    this->cost += 2;
+    for (int v : this->sub[w]) {
+        this->openCount[v]--;
+        this->inCount[v]++;
+        // A second neighbour in S makes an out vertex cost 1 for good
+        if (this->state[v] == OUT && this->inCount[v] == 2) this->cost += 1;
+    }
+}
+
+void ExactSolver::setOut(int w) {
+    this->state[w] = OUT;
+    this->undecided[w / 64] &= ~(uint64_t(1) << (w % 64));
+    if (this->inCount[w] >= 2 || (this->inCount[w] == 0 && this->openCount[w] == 0)) this->cost += 1;
+    for (int v : this->sub[w]) {
+        this->openCount[v]--;
+        // No neighbour left that could still cover v
+        if (this->state[v] == OUT && this->openCount[v] == 0 && this->inCount[v] == 0) this->cost += 1;
+    }
+}
+
+void ExactSolver::undoIn(int w, int previousCost) {
+    for (int v : this->sub[w]) {
+        this->openCount[v]++;
+        this->inCount[v]--;
+    }
+    this->state[w] = UNDECIDED;
+    this->undecided[w / 64] |= uint64_t(1) << (w % 64);
+    this->cost = previousCost;
+}
+
+void ExactSolver::undoOut(int w, int previousCost) {
+    for (int v : this->sub[w]) {
+        this->openCount[v]++;
+    }
+    this->state[w] = UNDECIDED;
+    this->undecided[w / 64] |= uint64_t(1) << (w % 64);
+    this->cost = previousCost;
+}
@@ -0,0 +1,73 @@
+#ifndef EXACT_SOLVER_HPP
+#define EXACT_SOLVER_HPP
+#include "RomanGraph.hpp"
+#include <chrono>
+#include <cstdint>
+
+// Native exact solver for perfect Roman domination, for the cases where Gurobi
+// is not available or a metaheuristic is overkill.
+//
+// A labelling is determined by its set S of label-2 vertices, and its weight is
+// 2|S| + #{v not in S whose number of neighbours in S is not 1}. The solver
+// works component by component:
+//   - components with at most GRAY_CODE_LIMIT vertices enumerate every S in
+//     Gray-code order, updating the counts of one neighbourhood per step;
+//   - larger components of small treewidth go to the TreeDecomposition DP;
+//   - the others are solved by branch and bound over "v in S" /
+//     "v not in S", with incremental neighbour counts and a covering bound
+//     computed on bitset neighbourhoods.
+// When the time limit runs out the best labelling found so far is kept and
+// isOptimal() is false.
+class ExactSolver {
+    public:
+        static constexpr int GRAY_CODE_LIMIT = 20;
+
+        explicit ExactSolver(const Adjacency& adj);
+        ~ExactSolver() = default;
+
+        // Returns true when every component was solved to optimality.
+        bool solve(double timeLimit);
+
+        const std::vector<int>& labels() const { return this->bestLabels; }
+        int weight() const { return this->bestWeight; }
+        bool isOptimal() const { return this->optimal; }
+        double elapsedTime() const { return this->elapsed; }
+        long long nodeCount() const { return this->nodes; }
+
+    private:
+        enum State : char { UNDECIDED, IN, OUT };
+
+        const Adjacency& adj;
+        std::vector<int> bestLabels;
+        int bestWeight = 0;
+        bool optimal = false;
+        double elapsed = 0.0;
+        long long nodes = 0;
+
+        // Branch-and-bound state for the component being solved
+        using Bitset = std::vector<uint64_t>;
+        Adjacency sub;
+        std::vector<Bitset> neighborBits;
+        std::vector<State> state;
+        std::vector<int> inCount;         // neighbours in S
+        std::vector<int> openCount;       // undecided neighbours
+        Bitset undecided;
+        int cost = 0;                     // weight already committed
+        int incumbent = 0;
+        std::vector<char> incumbentSet;
+        std::chrono::steady_clock::time_point deadline;
+        bool timedOut = false;
+
+        std::vector<int> solveComponent(const Adjacency& component, bool& proven);
+        static std::vector<int> solveByGrayCode(const Adjacency& component);
+        std::vector<char> greedySet() const;
+
+        void branch();
+        double lowerBound(int& branchVertex) const;
+        void setIn(int w);
+        void setOut(int w);
+        void undoIn(int w, int previousCost);
+        void undoOut(int w, int previousCost);
+};
+
+#endif
@@ -0,0 +1,86 @@
+#include "Greedy.hpp"
+#include "Profile.hpp"
+#include <algorithm>
+#include <cmath>
+
+std::vector<int> greedyPerfectRoman(const Adjacency& adj, double alpha, std::mt19937* random) {
+    const int UNDOMINATED = -1;
+    const int n = adj.size();
+    std::vector<int> labels(n, UNDOMINATED);
+    std::vector<int> key(n);
+    int top = 0;
+    for (int v = 0; v < n; v++) {
+        key[v] = adj[v].size();
+        top = std::max(top, key[v]);
+    }
+
+    // buckets[k] holds the undominated vertices of key k >= 2; position[v]
+    // is the index of v in its bucket, -1 when v is in none
+    std::vector<std::vector<int>> buckets(top + 1);
+    std::vector<int> position(n, -1);
+    auto insert = [&](int v) {
+        if (key[v] < 2) return;
+        position[v] = buckets[key[v]].size();
+        buckets[key[v]].push_back(v);
+        top = std::max(top, key[v]);
+    };
+    auto remove = [&](int v) {
+        if (position[v] < 0) return;
+        std::vector<int>& bucket = buckets[key[v]];
+        const int last = bucket.back();
+        bucket[position[v]] = last;
+        position[last] = position[v];
+        bucket.pop_back();
+        position[v] = -1;
+    };
+    auto update = [&](int v, int delta) {
+        remove(v);
+        key[v] += delta;
+        insert(v);
+    };
+    for (int v = 0; v < n; v++) insert(v);
+
+    while (true) {
+        while (top >= 2 && buckets[top].empty()) top--;
+        if (top < 2) break;
+
+        int v = buckets[top].back();
+        if (alpha > 0 && random != nullptr) {
+            const int threshold = std::max(2, static_cast<int>(std::ceil(top - alpha * (top - 2))));
+            size_t candidates = 0;
+            for (int k = threshold; k <= top; k++) candidates += buckets[k].size();
+            size_t pick = std::uniform_int_distribution<size_t>(0, candidates - 1)(*random);
+            int k = top;
+            while (pick >= buckets[k].size()) {
+                pick -= buckets[k].size();
+                k--;
+            }
+            v = buckets[k][pick];
+        }
+
+        remove(v);
+        labels[v] = 2;
+        PROFILE_COUNT("greedy.picks", 1);
+        for (int w : adj[v]) {
+            if (labels[w] == UNDOMINATED) {
+                // w leaves the queue as a 0: one undominated neighbour less
+                // and one 0 neighbour more for the vertices around it
+                remove(w);
+                labels[w] = 0;
+                for (int x : adj[w]) {
+                    if (labels[x] == UNDOMINATED) update(x, -2);
+                }
+            } else if (labels[w] == 0) {
+                labels[w] = 1;
+                for (int x : adj[w]) {
+                    if (labels[x] == UNDOMINATED) update(x, 1);
+                }
+            }
+        }
+    }
+
+    for (int& label : labels) {
+        if (label == UNDOMINATED) label = 1;
+    }
+    return labels;
+}
@@ -0,0 +1,20 @@
+#ifndef GREEDY_HPP
+#define GREEDY_HPP
+#include "RomanGraph.hpp"
+#include <random>
+
+// Greedy perfect Roman labelling. Every vertex starts undominated. Giving an
+// undominated v the label 2 turns its undominated neighbours into 0s and its
+// 0 neighbours, which already have their 2, into 1s; against labelling v and
+// those neighbours 1 it saves (undominated - 0 neighbours) - 1. A bucket queue
+// keyed by undominated - 0 neighbours takes a vertex of largest key while the
+// key is at least 2, and the vertices left undominated get 1. A key changes
+// only when a neighbour is labelled, and a vertex is labelled at most twice
+// (0, then 1), so the construction takes O(n + m).
+//
+// With alpha > 0 and a generator, the vertex is drawn uniformly from the
+// restricted candidate list of keys >= top - alpha (top - 2), as in GRASP;
+// every draw adds O(top) to the construction.
+std::vector<int> greedyPerfectRoman(const Adjacency& adj, double alpha = 0.0, std::mt19937* random = nullptr);
+
+#endif
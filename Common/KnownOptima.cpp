@@ -0,0 +1,70 @@
+#include "KnownOptima.hpp"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> splitCsvLine(const std::string& line) {
+    std::vector<std::string> fields;
+    std::stringstream stream(line);
+    std::string field;
+    while (std::getline(stream, field, ',')) {
+        // Trim spaces and a trailing '\r' from files written on Windows
+        const size_t first = field.find_first_not_of(" \t\r");
+        const size_t last = field.find_last_not_of(" \t\r");
+        fields.push_back(first == std::string::npos ? "" : field.substr(first, last - first + 1));
+    }
+    return fields;
+}
+
+int findColumn(const std::vector<std::string>& header, std::initializer_list<const char*> names) {
+    for (const char* name : names) {
+        auto it = std::find(header.begin(), header.end(), name);
+        if (it != header.end()) return it - header.begin();
+    }
+    return -1;
+}
+
+}
+
+std::map<std::string, int> readKnownOptima(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Error opening file: " + path);
+    }
+
+    std::string line;
+    std::getline(file, line);
+    const std::vector<std::string> header = splitCsvLine(line);
+    const int nameColumn = findColumn(header, {"Graph", "graph_name"});
+    const int weightColumn = findColumn(header, {"Fitness", "objective_value", "fitness_value"});
+    if (nameColumn == -1 || weightColumn == -1) {
+        throw std::runtime_error("readKnownOptima: no graph or weight column in " + path);
+    }
+
+    std::map<std::string, int> optima;
+    while (std::getline(file, line)) {
+        const std::vector<std::string> fields = splitCsvLine(line);
+        if (static_cast<int>(fields.size()) <= std::max(nameColumn, weightColumn)) continue;
+
+        // BRKGA writes the file name, the other front ends the stem
+        const std::string name = std::filesystem::path(fields[nameColumn]).stem().string();
+        const int weight = static_cast<int>(std::lround(std::stod(fields[weightColumn])));
+        if (weight < 0) continue;   // PI writes -1 when Gurobi found nothing
+
+        auto it = optima.find(name);
+        if (it == optima.end() || weight < it->second) optima[name] = weight;
+    }
+    return optima;
+}
+
+int targetFor(const std::string& graphName, int target, const std::map<std::string, int>& knownOptima) {
+    if (target >= 0) return target;
+    auto it = knownOptima.find(std::filesystem::path(graphName).stem().string());
+    return it == knownOptima.end() ? -1 : it->second;
+}
@@ -0,0 +1,17 @@
+#ifndef KNOWN_OPTIMA_HPP
+#define KNOWN_OPTIMA_HPP
+#include <map>
+#include <string>
+
+// Best known weights, keyed by graph name (file stem). Reads the results CSVs
+// of this repository: the Analises/*_PLI_results.csv tables (Graph, Fitness)
+// as well as the raw PI/Exact (graph_name, objective_value) and GA/BRKGA
+// (graph_name, fitness_value) outputs. A graph listed more than once keeps
+// its lowest weight.
+std::map<std::string, int> readKnownOptima(const std::string& path);
+
+// Target weight for 'graphName': 'target' when it is set (>= 0), otherwise the
+// entry in 'knownOptima', otherwise -1 (no target).
+int targetFor(const std::string& graphName, int target, const std::map<std::string, int>& knownOptima);
+
+#endif
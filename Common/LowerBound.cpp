@@ -0,0 +1,112 @@
+#include "LowerBound.hpp"
+#include "ExactSolver.hpp"
+#include "TreeDecomposition.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <numeric>
+
+int degreeBound(const Adjacency& adj) {
+    const int n = adj.size();
+    std::vector<int> degrees(n);
+    for (int u = 0; u < n; u++) degrees[u] = adj[u].size();
+    std::sort(degrees.begin(), degrees.end(), std::greater<int>());
+
+    int best = n;
+    long long covered = 0;
+    for (int a = 1; a <= n; a++) {
+        covered += degrees[a - 1];
+        best = std::min<long long>(best, 2LL * a + std::max(0LL, n - a - covered));
+        if (2 * a >= best) break;
+    }
+    return best;
+}
+
+int packingBound(const Adjacency& adj) {
+    const int n = adj.size();
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return adj[a].size() < adj[b].size(); });
+
+    // A vertex joins the packing when no vertex of its closed neighbourhood is taken
+    std::vector<char> taken(n, false);
+    int packing = 0;
+    for (int v : order) {
+        bool free = !taken[v];
+        for (int u : adj[v]) free = free && !taken[u];
+        if (!free) continue;
+
+        taken[v] = true;
+        for (int u : adj[v]) taken[u] = true;
+        packing++;
+    }
+    return packing;
+}
+
+int dualBound(const Adjacency& adj) {
+    const int n = adj.size();
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return adj[a].size() < adj[b].size(); });
+
+    // slack[w] = 2 - sum of z over N[w]
+    std::vector<double> slack(n, 2.0);
+    double total = 0.0;
+    for (int v : order) {
+        double z = std::min(1.0, slack[v]);
+        for (int u : adj[v]) z = std::min(z, slack[u]);
+        if (z <= 0.0) continue;
+
+        slack[v] -= z;
+        for (int u : adj[v]) slack[u] -= z;
+        total += z;
+    }
+    return static_cast<int>(std::ceil(total - 1e-9));
+}
+
+int lowerBound(const Adjacency& adj, double exactTime) {
+    const std::vector<int> bounds = componentLowerBounds(adj, exactTime);
+    return std::accumulate(bounds.begin(), bounds.end(), 0);
+}
+
+std::vector<int> componentLowerBounds(const Adjacency& adj, double exactTime) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(exactTime));
+
+    std::vector<int> bounds;
+    for (const std::vector<int>& component : connectedComponents(adj)) {
+        if (component.size() == 1) {
+            bounds.push_back(1);
+            continue;
+        }
+        const Adjacency sub = inducedSubgraph(adj, component);
+
+        // Small or thin components are cheap to solve outright
+        const double remaining = std::chrono::duration<double>(deadline - std::chrono::steady_clock::now()).count();
+        if (remaining > 0) {
+            if (static_cast<int>(sub.size()) <= EXACT_BOUND_LIMIT) {
+                ExactSolver solver(sub);
+                if (solver.solve(remaining)) {
+                    bounds.push_back(solver.weight());
+                    continue;
+                }
+            } else {
+                TreeDecomposition decomposition(sub, TreeDecomposition::MAX_WIDTH, remaining);
+                if (decomposition.isTractable()) {
+                    bounds.push_back(labelWeight(decomposition.solve()));
+                    continue;
+                }
+            }
+        }
+
+        // A connected graph with two or more vertices needs weight at least 2
+        bounds.push_back(std::max({2, degreeBound(sub), packingBound(sub), dualBound(sub)}));
+    }
+    return bounds;
+}
+
+double relativeGap(int weight, int bound) {
+    if (weight <= 0) return 0.0;
+    return static_cast<double>(weight - bound) / weight;
+}
@@ -0,0 +1,36 @@
+#ifndef LOWER_BOUND_HPP
+#define LOWER_BOUND_HPP
+#include "RomanGraph.hpp"
+
+// Lower bounds on the perfect Roman domination number. Every bound below also
+// holds for Roman domination, of which a perfect Roman dominating function is
+// a special case.
+
+// With a vertices labelled 2, at most the sum D_a of the a largest degrees can
+// be labelled 0, so the weight is at least min_a 2a + max(0, n - a - D_a).
+int degreeBound(const Adjacency& adj);
+
+// The closed neighbourhoods of a 2-packing are disjoint and each one carries
+// weight at least 1, so any greedy 2-packing gives a bound.
+int packingBound(const Adjacency& adj);
+
+// Greedy feasible solution of the dual of the Roman domination LP
+//     max sum z_v  s.t.  z_v <= 1,  sum_{u in N[v]} z_u <= 2,  z >= 0,
+// filled in order of increasing degree.
+int dualBound(const Adjacency& adj);
+
+// Sum over the connected components of the best of the bounds above. A
+// component of small treewidth, or one with at most EXACT_BOUND_LIMIT vertices
+// that the exact solver settles within 'exactTime' seconds in total,
+// contributes its optimum instead.
+constexpr int EXACT_BOUND_LIMIT = 64;
+int lowerBound(const Adjacency& adj, double exactTime = 1.0);
+
+// The bound of each component, in the order of connectedComponents, with the
+// same 'exactTime' budget shared by all of them
+std::vector<int> componentLowerBounds(const Adjacency& adj, double exactTime = 1.0);
+
+// Relative gap between a solution weight and a lower bound, 0 when they meet.
+double relativeGap(int weight, int bound);
+
+#endif
@@ -0,0 +1,75 @@
+#include "Profile.hpp"
+
+#ifdef PRD_PROFILE
+
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+
+namespace profile {
+
+namespace {
+
+// A deque never moves its elements, so references handed out stay valid
+std::deque<Slot>& slots() {
+    static std::deque<Slot> instance;
+    return instance;
+}
+
+std::mutex& slotsMutex() {
+    static std::mutex instance;
+    return instance;
+}
+
+}
+
+Slot& slot(const char* name, bool timed) {
+    std::lock_guard<std::mutex> lock(slotsMutex());
+    for (Slot& s : slots()) {
+        if (std::strcmp(s.name, name) == 0) return s;
+    }
+    slots().emplace_back();
+    slots().back().name = name;
+    slots().back().timed = timed;
+    return slots().back();
+}
+
+void reset() {
+    std::lock_guard<std::mutex> lock(slotsMutex());
+    for (Slot& s : slots()) {
+        s.nanoseconds.store(0, std::memory_order_relaxed);
+        s.count.store(0, std::memory_order_relaxed);
+    }
+}
+
+// One JSON object per line: timed scopes under "stages", plain counters under "counters"
+void report(const std::string& path, const std::string& graphName, const std::string& algorithm, int run) {
+    std::ofstream file(path, std::ios::app);
+    if (!file.is_open()) {
+        throw std::runtime_error("Error opening file: " + path);
+    }
+
+    std::lock_guard<std::mutex> lock(slotsMutex());
+    file << "{\"graph\":\"" << graphName << "\",\"algorithm\":\"" << algorithm << "\",\"run\":" << run << ",\"stages\":{";
+    bool first = true;
+    for (const Slot& s : slots()) {
+        if (!s.timed) continue;
+        file << (first ? "" : ",") << "\"" << s.name << "\":{\"seconds\":" << s.nanoseconds.load(std::memory_order_relaxed) * 1e-9
+             << ",\"calls\":" << s.count.load(std::memory_order_relaxed) << "}";
+        first = false;
+    }
+    file << "},\"counters\":{";
+    first = true;
+    for (const Slot& s : slots()) {
+        if (s.timed) continue;
+        file << (first ? "" : ",") << "\"" << s.name << "\":" << s.count.load(std::memory_order_relaxed);
+        first = false;
+    }
+    file << "}}\n";
+}
+
+}
+
+#endif
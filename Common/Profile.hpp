@@ -0,0 +1,80 @@
+#ifndef PROFILE_HPP
+#define PROFILE_HPP
+
+// Instrumentation switched on at compile time with -DPRD_PROFILE (make
+// PROFILE=1). Without it every macro below expands to nothing, so the
+// instrumented code is exactly the uninstrumented one.
+//
+//   PROFILE_SCOPE("ga.selection");     time the enclosing scope, count calls
+//   PROFILE_COUNT("rng.draws", k);      add k to a counter
+//   PROFILE_RESET();                    zero everything before a run
+//   PROFILE_REPORT(path, graph, algorithm, run);
+//                                       append the totals as one JSON line
+//
+// Slots are looked up by name once per call site and updated with relaxed
+// atomics, so scopes may sit inside OpenMP loops. Runs that execute
+// concurrently share the totals.
+
+#ifdef PRD_PROFILE
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+namespace profile {
+
+struct Slot {
+    const char* name;
+    bool timed;     // a scope rather than a plain counter
+    std::atomic<long long> nanoseconds{0};
+    std::atomic<long long> count{0};
+};
+
+// The slot called 'name', created on first use; the reference stays valid.
+Slot& slot(const char* name, bool timed);
+
+void reset();
+void report(const std::string& path, const std::string& graphName, const std::string& algorithm, int run);
+
+class Scope {
+    public:
+        explicit Scope(Slot& slot) : slot(slot), begin(std::chrono::steady_clock::now()) {}
+        ~Scope() {
+            const auto elapsed = std::chrono::steady_clock::now() - this->begin;
+            this->slot.nanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), std::memory_order_relaxed);
+            this->slot.count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Slot& slot;
+        std::chrono::steady_clock::time_point begin;
+};
+
+}
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(name) \
+    static profile::Slot& PROFILE_CONCAT(profileSlot, __LINE__) = profile::slot(name, true); \
+    profile::Scope PROFILE_CONCAT(profileScope, __LINE__)(PROFILE_CONCAT(profileSlot, __LINE__))
+#define PROFILE_COUNT(name, amount) \
+    do { \
+        static profile::Slot& profileCounter = profile::slot(name, false); \
+        profileCounter.count.fetch_add((amount), std::memory_order_relaxed); \
+    } while (0)
+#define PROFILE_RESET() profile::reset()
+#define PROFILE_REPORT(path, graphName, algorithm, run) profile::report((path), (graphName), (algorithm), (run))
+
+#else
+
+#define PROFILE_SCOPE(name) do {} while (0)
+#define PROFILE_COUNT(name, amount) do {} while (0)
+#define PROFILE_RESET() do {} while (0)
+#define PROFILE_REPORT(path, graphName, algorithm, run) do {} while (0)
+
+#endif
+
+#endif
@@ -0,0 +1,254 @@
+#include "Reduction.hpp"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+
+Reduction::Reduction(const Adjacency& adj) : originalOrder(adj.size()), originalSize(countEdges(adj)), current(adj),
+    alive(adj.size(), true), fixedLabels(adj.size(), -1) {
+    this->buildKernel();
+}
+
+void Reduction::apply() {
+    // Shortening a chain can turn its component into a small one, so keep going
+    // until neither rule changes anything.
+    bool changed = true;
+    while (changed) {
+        changed = this->reduceComponents();
+        changed = this->shortenChains() || changed;
+    }
+    this->buildKernel();
+}
+
+bool Reduction::reduceComponents() {
+    const int n = this->current.size();
+    bool changed = false;
+    std::vector<char> visited(n, false);
+    std::vector<int> stack;
+
+    for (int s = 0; s < n; s++) {
+        if (!this->alive[s] || visited[s]) continue;
+
+        std::vector<int> component;
+        visited[s] = true;
+        stack.push_back(s);
+        while (!stack.empty()) {
+            int u = stack.back();
+            stack.pop_back();
+            component.push_back(u);
+            for (int v : this->current[u]) {
+                if (!visited[v]) {
+                    visited[v] = true;
+                    stack.push_back(v);
+                }
+            }
+        }
+        const int size = component.size();
+
+        // Isolated vertex: it cannot be 0, and 1 is cheaper than 2
+        if (size == 1) {
+            this->fixedLabels[s] = 1;
+            this->alive[s] = false;
+            this->offset += 1;
+            this->isolatedVertices++;
+            changed = true;
+            continue;
+        }
+
+        // Any connected graph with two or more vertices needs weight >= 2,
+        // which a universal vertex labelled 2 achieves
+        int universal = -1;
+        for (int u : component) {
+            if (static_cast<int>(this->current[u].size()) == size - 1) {
+                universal = u;
+                break;
+            }
+        }
+        if (universal != -1) {
+            for (int u : component) {
+                this->fixedLabels[u] = (u == universal) ? 2 : 0;
+                this->alive[u] = false;
+            }
+            this->offset += 2;
+            this->universalComponents++;
+            changed = true;
+            continue;
+        }
+
+        if (size <= SMALL_COMPONENT) {
+            std::sort(component.begin(), component.end());
+            std::vector<int> labels = solveByEnumeration(inducedSubgraph(this->current, component));
+            for (int i = 0; i < size; i++) {
+                this->fixedLabels[component[i]] = labels[i];
+                this->alive[component[i]] = false;
+            }
+            this->offset += labelWeight(labels);
+            this->smallComponents++;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+bool Reduction::shortenChains() {
+    const int n = this->current.size();
+    bool changed = false;
+    std::vector<char> visited(n, false);
+
+    auto isInterior = [&](int u) { return this->current[u].size() == 2; };
+
+    // Follows degree-2 vertices starting at 'next', coming from 'from'.
+    // Returns the first vertex that is not interior (the anchor).
+    auto walk = [&](int start, int from, int next, std::vector<int>& out) {
+        int prev = from;
+        int cur = next;
+        while (cur != start && isInterior(cur)) {
+            out.push_back(cur);
+            int nxt = (this->current[cur][0] == prev) ? this->current[cur][1] : this->current[cur][0];
+            prev = cur;
+            cur = nxt;
+        }
+        return cur;
+    };
+
+    for (int v = 0; v < n; v++) {
+        if (!this->alive[v] || visited[v] || !isInterior(v)) continue;
+
+        std::vector<int> left, right;
+        int last = walk(v, v, this->current[v][1], right);
+        if (last == v) {
+            // A component that is just a cycle has no anchor; leave it alone
+            visited[v] = true;
+            for (int u : right) visited[u] = true;
+            continue;
+        }
+        int first = walk(v, v, this->current[v][0], left);
+
+        std::vector<int> chain(left.rbegin(), left.rend());
+        chain.push_back(v);
+        chain.insert(chain.end(), right.begin(), right.end());
+        for (int u : chain) visited[u] = true;
+
+        const int k = chain.size();
+        if (k < MIN_CHAIN) continue;
+
+        // Keep chain[0 .. kept-2] and chain[k-1], drop the 3t vertices in between
+        const int t = (k - 4) / 3;
+        const int kept = k - 3 * t;
+        const int x = chain[kept - 2];
+        const int y = chain[k - 1];
+        std::replace(this->current[x].begin(), this->current[x].end(), chain[kept - 1], y);
+        std::replace(this->current[y].begin(), this->current[y].end(), chain[k - 2], x);
+        for (int i = kept - 1; i <= k - 2; i++) {
+            this->alive[chain[i]] = false;
+            this->current[chain[i]].clear();
+        }
+
+        this->chains.push_back({first, last, chain});
+        this->offset += 2 * t;
+        this->shortenedChains++;
+        changed = true;
+    }
+    return changed;
+}
+
+void Reduction::buildKernel() {
+    const int n = this->current.size();
+    std::vector<int> position(n, -1);
+    this->kernelToOriginal.clear();
+    for (int u = 0; u < n; u++) {
+        if (this->alive[u]) {
+            position[u] = this->kernelToOriginal.size();
+            this->kernelToOriginal.push_back(u);
+        }
+    }
+
+    this->kernelAdj.assign(this->kernelToOriginal.size(), {});
+    for (int i = 0; i < static_cast<int>(this->kernelToOriginal.size()); i++) {
+        for (int v : this->current[this->kernelToOriginal[i]]) {
+            this->kernelAdj[i].push_back(position[v]);
+        }
+        std::sort(this->kernelAdj[i].begin(), this->kernelAdj[i].end());
+    }
+}
+
+std::vector<int> Reduction::lift(const std::vector<int>& kernelLabels) const {
+    if (kernelLabels.size() != this->kernelToOriginal.size()) {
+        throw std::invalid_argument("Reduction::lift: labelling does not match the kernel.");
+    }
+
+    std::vector<int> labels = this->fixedLabels;
+    for (int i = 0; i < static_cast<int>(kernelLabels.size()); i++) {
+        labels[this->kernelToOriginal[i]] = kernelLabels[i];
+    }
+
+    // Undo the chain contractions, last one first
+    for (auto it = this->chains.rbegin(); it != this->chains.rend(); ++it) {
+        resolveChain(*it, labels);
+    }
+    return labels;
+}
+
+// Relabels the whole interior of a chain at minimum cost, keeping the label-2
+// status of its two ends. The anchors only see those two vertices, so they stay
+// valid; by the period-3 argument the cost grows by at most the removed offset.
+void Reduction::resolveChain(const ChainContraction& c, std::vector<int>& labels) {
+    const int INF = std::numeric_limits<int>::max() / 2;
+    const int k = c.chain.size();
+    const int before = labels[c.first] == 2;
+    const int after = labels[c.last] == 2;
+    const int firstTwo = labels[c.chain[0]] == 2;
+    const int lastTwo = labels[c.chain[k - 1]] == 2;
+
+    // Cost of vertex i given its own status and the status of both path neighbours
+    auto cost = [](int prev, int cur, int next) { return cur ? 2 : ((prev + next) != 1); };
+
+    // dp[i][a][b]: cheapest cost of vertices 0..i-1 with s[i-1] = a and s[i] = b
+    std::vector<std::array<std::array<int, 2>, 2>> dp(k);
+    std::vector<std::array<std::array<int, 2>, 2>> back(k);
+    for (auto& table : dp) table = {{{INF, INF}, {INF, INF}}};
+    dp[0][before][firstTwo] = 0;
+
+    for (int i = 0; i + 1 < k; i++) {
+        for (int a = 0; a < 2; a++) {
+            for (int b = 0; b < 2; b++) {
+                if (dp[i][a][b] >= INF) continue;
+                for (int next = 0; next < 2; next++) {
+                    if (i + 1 == k - 1 && next != lastTwo) continue;
+                    int value = dp[i][a][b] + cost(a, b, next);
+                    if (value < dp[i + 1][b][next]) {
+                        dp[i + 1][b][next] = value;
+                        back[i + 1][b][next] = a;
+                    }
+                }
+            }
+        }
+    }
+
+    auto total = [&](int a) { return dp[k - 1][a][lastTwo] + cost(a, lastTwo, after); };
+    const int bestPrev = (total(1) < total(0)) ? 1 : 0;
+
+    // s[j] holds the status of chain[j - 1]; s[0] and s[k + 1] are the anchors
+    std::vector<int> s(k + 2);
+    s[0] = before;
+    s[k + 1] = after;
+    s[k] = lastTwo;
+    s[k - 1] = bestPrev;
+    for (int i = k - 2; i >= 1; i--) {
+        s[i] = back[i + 1][s[i + 1]][s[i + 2]];
+    }
+
+    for (int i = 1; i <= k; i++) {
+        labels[c.chain[i - 1]] = s[i] ? 2 : (((s[i - 1] + s[i + 1]) == 1) ? 0 : 1);
+    }
+}
+
+void Reduction::printSummary(std::ostream& os) const {
+    os << "Reduction: n " << this->originalOrder << " -> " << this->kernelAdj.size()
+       << ", m " << this->originalSize << " -> " << countEdges(this->kernelAdj)
+       << ", fixed weight " << this->offset
+       << " (isolated " << this->isolatedVertices
+       << ", universal components " << this->universalComponents
+       << ", small components " << this->smallComponents
+       << ", shortened chains " << this->shortenedChains << ")" << std::endl;
+}
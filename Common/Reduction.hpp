@@ -0,0 +1,65 @@
+#ifndef REDUCTION_HPP
+#define REDUCTION_HPP
+#include "RomanGraph.hpp"
+#include <iostream>
+
+// Exact preprocessing for perfect Roman domination.
+//
+// The rules below never change the optimum: opt(G) = opt(kernel) + fixedWeight().
+//   - isolated vertices get label 1;
+//   - a component with a universal vertex costs 2 (2 on that vertex, 0 elsewhere);
+//   - components with at most SMALL_COMPONENT vertices are solved by enumeration;
+//   - a chain of k >= 7 degree-2 vertices is shortened by 3t vertices, which lowers
+//     the optimum by exactly 2t (the min-plus transfer of a path has period 3 and
+//     increment 2 from length 4 onwards, for every state of its two ends).
+// Twin and pendant rules are deliberately left out: collapsing twins or leaves is
+// only exact with vertex weights, which neither the GA nor the BRKGA supports.
+class Reduction {
+    public:
+        static constexpr int SMALL_COMPONENT = 12;
+        static constexpr int MIN_CHAIN = 7;
+
+        explicit Reduction(const Adjacency& adj);
+        ~Reduction() = default;
+
+        // Applies the rules until none of them changes the graph.
+        void apply();
+
+        const Adjacency& kernel() const { return this->kernelAdj; }
+        int fixedWeight() const { return this->offset; }
+
+        // Maps a labelling of the kernel back to a labelling of the original graph
+        // whose weight is at most weight(kernelLabels) + fixedWeight().
+        std::vector<int> lift(const std::vector<int>& kernelLabels) const;
+
+        void printSummary(std::ostream& os) const;
+
+        int isolatedVertices = 0;
+        int universalComponents = 0;
+        int smallComponents = 0;
+        int shortenedChains = 0;
+
+    private:
+        struct ChainContraction {
+            int first;               // anchor before chain[0]
+            int last;                // anchor after chain.back()
+            std::vector<int> chain;  // interior vertices, in path order
+        };
+
+        int originalOrder;
+        int originalSize;
+        Adjacency current;               // working copy, edited by the chain rule
+        std::vector<char> alive;
+        std::vector<int> fixedLabels;    // -1 while the vertex is still in the graph
+        std::vector<ChainContraction> chains;
+        Adjacency kernelAdj;
+        std::vector<int> kernelToOriginal;
+        int offset = 0;
+
+        bool reduceComponents();
+        bool shortenChains();
+        void buildKernel();
+        static void resolveChain(const ChainContraction& c, std::vector<int>& twos);
+};
+
+#endif
@@ -0,0 +1,170 @@
+#include "Reorder.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+// Breadth-first search from 'root' over the unplaced vertices, appending them
+// to 'sequence'; with 'byDegree' the neighbours of a vertex are visited in
+// increasing degree. Returns the number of levels.
+int breadthFirst(const Adjacency& adj, int root, bool byDegree, std::vector<char>& placed, std::vector<int>& sequence) {
+    const size_t start = sequence.size();
+    placed[root] = true;
+    sequence.push_back(root);
+    std::vector<int> next;
+    int levels = 0;
+    size_t levelEnd = sequence.size();
+    for (size_t head = start; head < sequence.size(); head++) {
+        if (head == levelEnd) {
+            levels++;
+            levelEnd = sequence.size();
+        }
+        next.clear();
+        for (int w : adj[sequence[head]]) {
+            if (!placed[w]) {
+                placed[w] = true;
+                next.push_back(w);
+            }
+        }
+        if (byDegree) {
+            std::stable_sort(next.begin(), next.end(), [&](int a, int b) { return adj[a].size() < adj[b].size(); });
+        }
+        sequence.insert(sequence.end(), next.begin(), next.end());
+    }
+    return levels + 1;
+}
+
+// Pseudo-peripheral vertex of the component of 'root' (George and Liu, 1979):
+// a vertex of smallest degree in the last BFS level, until the number of
+// levels stops growing. 'marked' and 'distance' are false and -1 for every
+// vertex, and are left so.
+int peripheralVertex(const Adjacency& adj, int root, std::vector<char>& marked, std::vector<int>& distance) {
+    std::vector<int> component;
+    int levels = breadthFirst(adj, root, false, marked, component);
+    while (true) {
+        // BFS order visits every vertex after the one it was reached from
+        distance[root] = 0;
+        for (int v : component) {
+            for (int w : adj[v]) {
+                if (distance[w] < 0) distance[w] = distance[v] + 1;
+            }
+        }
+        int candidate = -1;
+        for (int v : component) {
+            if (distance[v] == levels - 1 && (candidate < 0 || adj[v].size() < adj[candidate].size())) {
+                candidate = v;
+            }
+        }
+        for (int v : component) {
+            marked[v] = false;
+            distance[v] = -1;
+        }
+
+        std::vector<int> order;
+        const int candidateLevels = breadthFirst(adj, candidate, false, marked, order);
+        for (int v : order) marked[v] = false;
+        if (candidateLevels <= levels) return root;
+        root = candidate;
+        levels = candidateLevels;
+        component.swap(order);
+        for (int v : component) marked[v] = true;
+    }
+}
+
+int bandwidthOf(const Adjacency& adj, const std::vector<int>& position) {
+    int bandwidth = 0;
+    for (int u = 0; u < static_cast<int>(adj.size()); u++) {
+        for (int w : adj[u]) bandwidth = std::max(bandwidth, std::abs(position[u] - position[w]));
+    }
+    return bandwidth;
+}
+
+}
+
+VertexOrder parseVertexOrder(const std::string& name) {
+    if (name == "none") return VertexOrder::NONE;
+    if (name == "rcm") return VertexOrder::RCM;
+    if (name == "degree") return VertexOrder::DEGREE;
+    if (name == "bfs") return VertexOrder::BFS;
+    throw std::invalid_argument("unknown vertex order " + name + " (none, rcm, degree or bfs)");
+}
+
+std::string vertexOrderName(VertexOrder order) {
+    switch (order) {
+        case VertexOrder::RCM: return "rcm";
+        case VertexOrder::DEGREE: return "degree";
+        case VertexOrder::BFS: return "bfs";
+        default: return "none";
+    }
+}
+
+std::vector<int> vertexSequence(const Adjacency& adj, VertexOrder order) {
+    const int n = adj.size();
+    std::vector<int> sequence;
+    sequence.reserve(n);
+    if (order == VertexOrder::NONE) {
+        sequence.resize(n);
+        std::iota(sequence.begin(), sequence.end(), 0);
+        return sequence;
+    }
+
+    // Vertices by increasing degree, ties by id
+    std::vector<int> byDegree(n);
+    std::iota(byDegree.begin(), byDegree.end(), 0);
+    std::stable_sort(byDegree.begin(), byDegree.end(), [&](int a, int b) { return adj[a].size() < adj[b].size(); });
+
+    if (order == VertexOrder::DEGREE) {
+        sequence.resize(n);
+        std::iota(sequence.begin(), sequence.end(), 0);
+        std::stable_sort(sequence.begin(), sequence.end(), [&](int a, int b) { return adj[a].size() > adj[b].size(); });
+        return sequence;
+    }
+
+    // One search per component, from its smallest-degree vertex for RCM and
+    // from its largest-degree vertex for BFS
+    std::vector<char> placed(n, false);
+    if (order == VertexOrder::RCM) {
+        std::vector<char> marked(n, false);
+        std::vector<int> distance(n, -1);
+        for (int v : byDegree) {
+            if (!placed[v]) breadthFirst(adj, peripheralVertex(adj, v, marked, distance), true, placed, sequence);
+        }
+        std::reverse(sequence.begin(), sequence.end());
+    } else {
+        for (auto it = byDegree.rbegin(); it != byDegree.rend(); ++it) {
+            if (!placed[*it]) breadthFirst(adj, *it, false, placed, sequence);
+        }
+    }
+    return sequence;
+}
+
+VertexOrdering::VertexOrdering(const Adjacency& adj, VertexOrder order)
+    : sequence(vertexSequence(adj, order)), position(adj.size()), relabelled(adj.size()) {
+    const int n = adj.size();
+    std::vector<int> identity(n);
+    std::iota(identity.begin(), identity.end(), 0);
+    this->inputBandwidth = bandwidthOf(adj, identity);
+
+    for (int u = 0; u < n; u++) this->position[this->sequence[u]] = u;
+    for (int u = 0; u < n; u++) {
+        std::vector<int>& neighbours = this->relabelled[u];
+        neighbours.reserve(adj[this->sequence[u]].size());
+        for (int w : adj[this->sequence[u]]) neighbours.push_back(this->position[w]);
+        std::sort(neighbours.begin(), neighbours.end());
+    }
+    this->relabelledBandwidth = bandwidthOf(adj, this->position);
+}
+
+std::vector<int> VertexOrdering::restore(const std::vector<int>& labels) const {
+    std::vector<int> original(labels.size());
+    for (size_t u = 0; u < labels.size(); u++) original[this->sequence[u]] = labels[u];
+    return original;
+}
+
+std::vector<int> VertexOrdering::apply(const std::vector<int>& labels) const {
+    std::vector<int> relabelled(labels.size());
+    for (size_t u = 0; u < labels.size(); u++) relabelled[u] = labels[this->sequence[u]];
+    return relabelled;
+}
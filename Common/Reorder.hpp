@@ -0,0 +1,55 @@
+#ifndef REORDER_HPP
+#define REORDER_HPP
+#include "RomanGraph.hpp"
+#include <string>
+
+// Relabelling of the vertices for locality. The ids of the input files follow
+// no pattern, so the neighbours of a vertex are scattered over every array
+// indexed by vertex (labels, counts, keys) and most neighbour reads miss the
+// cache. Numbering the vertices so that neighbours get nearby ids turns those
+// reads into a few cache lines. The solvers search the relabelled graph and
+// map their labellings back to the input ids with restore().
+//   - RCM: reverse Cuthill-McKee (George and Liu, 1981), BFS from a
+//     pseudo-peripheral vertex with the neighbours in increasing degree,
+//     reversed; it keeps the bandwidth of the adjacency matrix small;
+//   - DEGREE: decreasing degree, so the hubs, read by most neighbourhoods,
+//     share the first cache lines;
+//   - BFS: breadth-first from the vertex of largest degree of each component.
+enum class VertexOrder { NONE, RCM, DEGREE, BFS };
+
+// "none", "rcm", "degree" or "bfs"; throws std::invalid_argument otherwise
+VertexOrder parseVertexOrder(const std::string& name);
+std::string vertexOrderName(VertexOrder order);
+
+class VertexOrdering {
+    public:
+        VertexOrdering(const Adjacency& adj, VertexOrder order);
+
+        // The relabelled graph: original vertex v is vertex newId(v) here
+        const Adjacency& graph() const { return this->relabelled; }
+
+        int newId(int v) const { return this->position[v]; }
+        int oldId(int u) const { return this->sequence[u]; }
+
+        // Labelling of the relabelled graph -> labelling of the original one
+        std::vector<int> restore(const std::vector<int>& labels) const;
+        // Labelling of the original graph -> labelling of the relabelled one
+        std::vector<int> apply(const std::vector<int>& labels) const;
+
+        // Largest |newId(u) - newId(v)| over the edges, the bandwidth of the
+        // matrix, and its value for the input ids
+        int bandwidth() const { return this->relabelledBandwidth; }
+        int originalBandwidth() const { return this->inputBandwidth; }
+
+    private:
+        std::vector<int> sequence;      // original id of every new id
+        std::vector<int> position;      // new id of every original id
+        Adjacency relabelled;
+        int relabelledBandwidth = 0;
+        int inputBandwidth = 0;
+};
+
+// Original ids in the given order
+std::vector<int> vertexSequence(const Adjacency& adj, VertexOrder order);
+
+#endif
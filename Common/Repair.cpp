@@ -0,0 +1,295 @@
+#include "Repair.hpp"
+#include "Profile.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+// Some neighbour v of u is a 0 whose count passes 'test'
+template <class Test>
+bool anyZeroAround(const Adjacency& adj, int u, const Labelling& label, const std::vector<int>& count, Test test) {
+    for (int v : adj[u]) {
+        if (label[v] == 0 && test(count[v])) return true;
+    }
+    return false;
+}
+
+// Same over the whole row, without a branch: a padding slot reads u itself,
+// which the rules ask about only while it is a 2 or a 0 with count 0, so it
+// never passes
+template <int D, class Test>
+bool anyZeroAround(const FixedDegreeAdjacency<D>& adj, int u, const Labelling& label, const std::vector<int>& count,
+                   Test test) {
+    const int n = adj.order();
+    bool any = false;
+    for (int v : adj.row(u)) {
+        const int w = v == n ? u : v;
+        any |= (label[w] == 0) & test(count[w]);
+    }
+    return any;
+}
+
+}
+
+template <class Body>
+void RepairEngine::withGraph(Body&& body) {
+    static const BoundedAdjacency unbounded;
+    withBoundedDegree(this->bounded ? *this->bounded : unbounded, this->adj, body);
+}
+
+void RepairEngine::load(const Labelling& labels) {
+    const int n = labels.size();
+    this->label = labels;
+    this->count.assign(n, 0);
+    if (this->dense) {
+        VertexSet twos(n);
+        for (int v = 0; v < n; v++) {
+            if (labels[v] == 2) twos.set(v);
+        }
+        for (int v = 0; v < n; v++) this->count[v] = (labels[v] > 0) + this->dense->countIn(v, twos);
+    } else {
+        for (int v = 0; v < n; v++) {
+            if (labels[v] > 0) this->count[v]++;
+            if (labels[v] == 2) {
+                for (int w : this->adj[v]) this->count[w]++;
+            }
+        }
+    }
+    this->queueEverything();
+}
+
+void RepairEngine::adopt(Labelling labels, std::vector<int> counts) {
+    this->label = std::move(labels);
+    this->count = std::move(counts);
+    this->queueEverything();
+}
+
+// Every vertex may need a visit, so until the work is done the queue is all
+// of them and nothing more is queued. The flags are clear outside a phase.
+void RepairEngine::queueEverything() {
+    const size_t n = this->label.size();
+    if (this->queued.size() != n) {
+        this->queued.assign(n, 0);
+        this->changed.assign(n, 0);
+    }
+    if (this->dense) {
+        if (this->privateZeros.words() != VertexSet::wordsFor(n)) {
+            this->privateZeros = VertexSet(n);
+            this->dominatedZeros = VertexSet(n);
+        }
+        for (size_t v = 0; v < n; v++) this->refresh(v);
+    }
+    this->settled = false;
+    this->queue.resize(n);
+    std::iota(this->queue.begin(), this->queue.end(), 0);
+    this->everything = true;
+}
+
+void RepairEngine::setDense(const DenseAdjacency* dense) {
+    this->dense = dense;
+    this->settled = false;
+}
+
+void RepairEngine::setBounded(const BoundedAdjacency* bounded) {
+    this->bounded = bounded;
+}
+
+void RepairEngine::assign(const Labelling& labels) {
+    if (!this->settled || this->label.size() != labels.size()) {
+        this->load(labels);
+        return;
+    }
+    // Each change costs a visit of its neighbourhood; past a few of them a
+    // fresh count is cheaper
+    size_t changes = 0;
+    for (size_t v = 0; v < labels.size(); v++) {
+        if (labels[v] != this->label[v] && ++changes > labels.size() / 8) {
+            this->load(labels);
+            return;
+        }
+    }
+    for (size_t v = 0; v < labels.size(); v++) {
+        if (labels[v] != this->label[v]) this->setLabel(v, labels[v]);
+    }
+}
+
+void RepairEngine::fix() {
+    this->withGraph([&](const auto& graph) {
+        this->reducePhase(graph);
+        this->repairPhase(graph);
+        this->reducePhase(graph);
+    });
+    this->clear();
+    this->settled = true;
+}
+
+void RepairEngine::reduce() {
+    this->withGraph([&](const auto& graph) { this->reducePhase(graph); });
+    this->clear();
+    this->settled = false;
+}
+
+void RepairEngine::enqueue(int v) {
+    if (!this->everything && !this->queued[v]) {
+        this->queued[v] = 1;
+        this->queue.push_back(v);
+    }
+}
+
+// The sets of the bitset kernels after a change of the label or count of v
+void RepairEngine::refresh(int v) {
+    if (!this->dense) return;
+    const bool zero = this->label[v] == 0;
+    this->privateZeros.set(v, zero && this->count[v] == 1);
+    this->dominatedZeros.set(v, zero && this->count[v] >= 1);
+}
+
+void RepairEngine::setLabel(int v, int l) {
+    const int old = this->label[v];
+    const int twos = (l == 2) - (old == 2);
+    // A 2 next to v only cares whether v is a 0
+    const bool zeroChanged = (l == 0) != (old == 0);
+    this->label[v] = l;
+    this->count[v] += (l > 0) - (old > 0);
+    this->refresh(v);
+    this->enqueue(v);
+    if (this->everything) {
+        if (twos == 0) return;
+        for (int w : this->adj[v]) {
+            this->count[w] += twos;
+            this->refresh(w);
+        }
+        return;
+    }
+
+    for (int w : this->adj[v]) {
+        if (zeroChanged || this->label[w] != 2) this->enqueue(w);
+        if (twos == 0) continue;
+        this->count[w] += twos;
+        this->refresh(w);
+        // The 2s around w may have gained or lost w as their private 0; they
+        // are queued when the next reduce phase starts, once per 0
+        if (this->label[w] == 0 && !this->changed[w]) {
+            this->changed[w] = 1;
+            this->changedZeros.push_back(w);
+        }
+    }
+}
+
+void RepairEngine::enqueueChangedZeros() {
+    for (int w : this->changedZeros) {
+        this->changed[w] = 0;
+        // A 0 that got another label had its neighbours queued then
+        if (this->label[w] != 0) continue;
+        for (int x : this->adj[w]) {
+            if (this->label[x] == 2) this->enqueue(x);
+        }
+    }
+    this->changedZeros.clear();
+}
+
+// A 2 becomes 1 only when it loses its last private 0, which no 2 -> 1 change
+// can cause, and a 1 -> 0 change only alters the count of its own vertex, so
+// a pass over the queue in vertex order leaves nothing for its own rule
+template <class G>
+void RepairEngine::reducePhase(const G& graph) {
+    this->enqueueChangedZeros();
+    this->sortQueue();
+    const size_t size = this->dense && this->everything ? 0 : this->queue.size();
+    if (size == 0 && this->everything) this->reduceTwosDense();
+    for (size_t i = 0; i < size; i++) {
+        const int u = this->queue[i];
+        this->touched++;
+        if (this->label[u] != 2) continue;
+        const bool safe = this->dense ? !this->dense->intersects(u, this->privateZeros)
+                                      : !anyZeroAround(graph, u, this->label, this->count, [](int c) { return c == 1; });
+        if (safe) this->setLabel(u, 1);
+    }
+
+    // The second rule reads only the label and count of its own vertex, so
+    // the order of this pass does not matter
+    for (size_t i = 0; i < this->queue.size(); i++) {
+        const int v = this->queue[i];
+        this->touched++;
+        if (this->label[v] == 1 && this->count[v] == 2) {
+            // Only the count of v changes, so the neighbours need no visit
+            this->label[v] = 0;
+            this->count[v]--;
+            this->refresh(v);
+            PROFILE_COUNT("repair.reduced_labels", 1);
+        }
+    }
+}
+
+// A new 2 only dominates 0s that had no 2, and a new 1 dominates nobody, so
+// no repair creates another one
+template <class G>
+void RepairEngine::repairPhase(const G& graph) {
+    this->sortQueue();
+    const size_t size = this->queue.size();
+    for (size_t i = 0; i < size; i++) {
+        const int u = this->queue[i];
+        this->touched++;
+        if (this->label[u] != 0 || this->count[u] == 1) continue;
+        PROFILE_COUNT("repair.repaired_labels", 1);
+        if (this->count[u] >= 2) {
+            this->setLabel(u, 1);
+            continue;
+        }
+        const bool hasSomeDominated = this->dense ? this->dense->intersects(u, this->dominatedZeros)
+                                                  : anyZeroAround(graph, u, this->label, this->count, [](int c) { return c >= 1; });
+        this->setLabel(u, hasSomeDominated ? 1 : 2);
+    }
+}
+
+// The first reduce rule over every vertex of a dense graph. Until the first
+// 2 -> 1 change the private 0s are those of privateZeros; from then on the
+// 2s around each vertex are kept in SlicedCounters, so a change updates its
+// whole neighbourhood in a few word operations, and the counts are written
+// back once at the end.
+void RepairEngine::reduceTwosDense() {
+    const int n = this->label.size();
+    int u = 0;
+    for (; u < n; u++) {
+        this->touched++;
+        if (this->label[u] == 2 && !this->dense->intersects(u, this->privateZeros)) break;
+    }
+    if (u == n) return;
+
+    std::vector<int> twos(n);
+    VertexSet zeros(n);
+    for (int v = 0; v < n; v++) {
+        twos[v] = this->count[v] - (this->label[v] > 0);
+        if (this->label[v] == 0) zeros.set(v);
+    }
+    SlicedCounters twosAround(*this->dense, twos);
+
+    this->label[u] = 1;
+    twosAround.decrementNeighbours(u);
+    for (u++; u < n; u++) {
+        this->touched++;
+        if (this->label[u] != 2 || twosAround.anyOneAround(u, zeros)) continue;
+        this->label[u] = 1;
+        twosAround.decrementNeighbours(u);
+    }
+
+    for (int v = 0; v < n; v++) {
+        this->count[v] = (this->label[v] > 0) + twosAround.value(v);
+        this->refresh(v);
+    }
+}
+
+// Vertex order, as the full passes; a queue of every vertex already is
+void RepairEngine::sortQueue() {
+    if (!std::is_sorted(this->queue.begin(), this->queue.end())) {
+        std::sort(this->queue.begin(), this->queue.end());
+    }
+}
+
+void RepairEngine::clear() {
+    for (int v : this->queue) this->queued[v] = 0;
+    this->queue.clear();
+    for (int w : this->changedZeros) this->changed[w] = 0;
+    this->changedZeros.clear();
+    this->everything = false;
+}
@@ -0,0 +1,97 @@
+#ifndef REPAIR_HPP
+#define REPAIR_HPP
+#include "BoundedDegree.hpp"
+#include "DenseGraph.hpp"
+#include "RomanGraph.hpp"
+
+// Worklist repair and weight reduction of perfect Roman labellings, shared by
+// the GA repair (PRD::fixSolution) and the BRKGA decoder. The state is a
+// labelling and its dominance counts: a vertex labelled 1 or 2 counts itself,
+// and every 2 counts for each of its neighbours. The rules are those of the
+// original full passes:
+//   reduce, in two phases:
+//     - a 2 that is the only 2 of none of its 0 neighbours becomes 1;
+//     - a 1 with count 2, so with exactly one 2 neighbour, becomes 0;
+//   repair, for a 0 whose count is not 1:
+//     - with count >= 2 it becomes 1;
+//     - with count 0 it becomes 2 if none of its 0 neighbours is dominated
+//       yet, and 1 otherwise.
+// Only queued vertices are examined: those whose label changed, their
+// neighbours, and the 2s next to a 0 whose count changed. Every phase visits
+// its queue in vertex order, as the passes did, and a phase never creates work
+// for itself, so the result is the one of the full passes while the work
+// grows with the part of the labelling that changed. On dense graphs the
+// neighbourhood questions of the rules, "is there a private 0" and "is there
+// a dominated 0", go to the bitset kernels of DenseGraph.hpp, and a reduce
+// over every vertex counts the 2s around each one in SlicedCounters. On
+// graphs of bounded degree the same two questions scan the fixed-length rows
+// of BoundedDegree.hpp whole, unrolled and without a branch; the updates,
+// which must see the real neighbours only, keep the lists.
+class RepairEngine {
+    public:
+        explicit RepairEngine(const Adjacency& adj, const DenseAdjacency* dense = nullptr) : adj(adj), dense(dense) {}
+
+        // The bitset form of adj, or nullptr for the lists alone; the next
+        // labelling is loaded from scratch
+        void setDense(const DenseAdjacency* dense);
+
+        // The fixed-degree form of adj (see boundedAdjacency), or nullptr
+        void setBounded(const BoundedAdjacency* bounded);
+
+        // Starts from 'labels', counting from scratch; every vertex is queued
+        void load(const Labelling& labels);
+
+        // Same, from labels and counts that the caller already has
+        void adopt(Labelling labels, std::vector<int> counts);
+
+        // Moves from the current labelling to 'labels', queueing only around
+        // the vertices whose label differs. That needs a current labelling
+        // that no rule applies to, as fix() leaves; otherwise it loads.
+        void assign(const Labelling& labels);
+
+        // reduce, repair and reduce again: a feasible labelling at the end
+        void fix();
+
+        // The reduce phases alone
+        void reduce();
+
+        const Labelling& labels() const { return this->label; }
+        const std::vector<int>& counts() const { return this->count; }
+        Labelling& takeLabels() { return this->label; }
+
+        // Vertices examined by the rules, for throughput measurements
+        long long touched = 0;
+
+    private:
+        const Adjacency& adj;
+        const DenseAdjacency* dense;
+        const BoundedAdjacency* bounded = nullptr;
+        VertexSet privateZeros;         // 0s with count 1, kept only with dense
+        VertexSet dominatedZeros;       // 0s with count >= 1, kept only with dense
+        Labelling label;
+        std::vector<int> count;
+        std::vector<char> queued;
+        std::vector<int> queue;
+        std::vector<char> changed;      // 0s whose count changed since the last reduce phase
+        std::vector<int> changedZeros;
+        bool settled = false;       // no rule applies to the labelling
+        bool everything = false;    // the queue holds every vertex
+
+        // body(graph) on adj in its fixed-degree form when there is one
+        template <class Body> void withGraph(Body&& body);
+
+        // G is Adjacency or a FixedDegreeAdjacency, the graph of withGraph
+        template <class G> void reducePhase(const G& graph);
+        template <class G> void repairPhase(const G& graph);
+
+        void enqueue(int v);
+        void queueEverything();
+        void enqueueChangedZeros();
+        void sortQueue();
+        void setLabel(int v, int l);
+        void refresh(int v);
+        void reduceTwosDense();
+        void clear();
+};
+
+#endif
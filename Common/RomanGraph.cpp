@@ -0,0 +1,194 @@
+#include "RomanGraph.hpp"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+Adjacency readAdjacency(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Error opening file: " + path);
+    }
+
+    int numNodes, numEdges;
+    file >> numNodes >> numEdges;
+
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(numEdges);
+    int u, v;
+    while (file >> u >> v) {
+        edges.emplace_back(u, v);
+    }
+    return buildAdjacency(numNodes, edges);
+}
+
+Adjacency buildAdjacency(int numNodes, const std::vector<std::pair<int, int>>& edges) {
+    Adjacency adj(numNodes);
+    for (const auto& [u, v] : edges) {
+        if (u == v) continue; // Ignore self-loops
+        if (u < 0 || v < 0 || u >= numNodes || v >= numNodes) {
+            throw std::runtime_error("error: endpoint of edge does not exist (buildAdjacency)");
+        }
+        adj[u].push_back(v);
+        adj[v].push_back(u);
+    }
+    // Ignore multiple edges
+    for (std::vector<int>& neighbors : adj) {
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+    }
+    return adj;
+}
+
+int countEdges(const Adjacency& adj) {
+    size_t count = 0;
+    for (const std::vector<int>& neighbors : adj) {
+        count += neighbors.size();
+    }
+    // Each edge is counted two times
+    return static_cast<int>(count / 2);
+}
+
+std::vector<std::pair<int, int>> edgeList(const Adjacency& adj) {
+    std::vector<std::pair<int, int>> edges;
+    for (int u = 0; u < static_cast<int>(adj.size()); u++) {
+        for (int v : adj[u]) {
+            if (u < v) edges.emplace_back(u, v);
+        }
+    }
+    return edges;
+}
+
+std::vector<std::vector<int>> connectedComponents(const Adjacency& adj) {
+    const int n = adj.size();
+    std::vector<std::vector<int>> components;
+    std::vector<char> visited(n, false);
+    std::vector<int> stack;
+
+    for (int s = 0; s < n; s++) {
+        if (visited[s]) continue;
+        std::vector<int> component;
+        visited[s] = true;
+        stack.push_back(s);
+        while (!stack.empty()) {
+            int u = stack.back();
+            stack.pop_back();
+            component.push_back(u);
+            for (int v : adj[u]) {
+                if (!visited[v]) {
+                    visited[v] = true;
+                    stack.push_back(v);
+                }
+            }
+        }
+        std::sort(component.begin(), component.end());
+        components.push_back(std::move(component));
+    }
+    return components;
+}
+
+Adjacency inducedSubgraph(const Adjacency& adj, const std::vector<int>& vertices) {
+    std::vector<int> position(adj.size(), -1);
+    for (int i = 0; i < static_cast<int>(vertices.size()); i++) {
+        position[vertices[i]] = i;
+    }
+
+    Adjacency sub(vertices.size());
+    for (int i = 0; i < static_cast<int>(vertices.size()); i++) {
+        for (int v : adj[vertices[i]]) {
+            if (position[v] != -1) sub[i].push_back(position[v]);
+        }
+        std::sort(sub[i].begin(), sub[i].end());
+    }
+    return sub;
+}
+
+bool isPerfectRoman(const Adjacency& adj, const std::vector<int>& labels) {
+    if (labels.size() != adj.size()) return false;
+    for (int u = 0; u < static_cast<int>(adj.size()); u++) {
+        if (labels[u] < 0 || labels[u] > 2) return false;
+        if (labels[u] != 0) continue;
+        int count = 0;
+        for (int v : adj[u]) {
+            if (labels[v] == 2) count++;
+        }
+        if (count != 1) return false;
+    }
+    return true;
+}
+
+int labelWeight(const std::vector<int>& labels) {
+    int weight = 0;
+    for (int label : labels) {
+        weight += label;
+    }
+    return weight;
+}
+
+int labelWeight(const Labelling& labels) {
+    int weight = 0;
+    for (Label label : labels) {
+        weight += label;
+    }
+    return weight;
+}
+
+Labelling toLabelling(const std::vector<int>& labels) {
+    return Labelling(labels.begin(), labels.end());
+}
+
+std::vector<int> toInts(const Labelling& labels) {
+    return std::vector<int>(labels.begin(), labels.end());
+}
+
+std::vector<int> labelsFromTwos(const Adjacency& adj, const std::vector<char>& isTwo) {
+    const int n = adj.size();
+    std::vector<int> labels(n);
+    for (int u = 0; u < n; u++) {
+        if (isTwo[u]) {
+            labels[u] = 2;
+            continue;
+        }
+        int count = 0;
+        for (int v : adj[u]) {
+            if (isTwo[v]) count++;
+        }
+        labels[u] = (count == 1) ? 0 : 1;
+    }
+    return labels;
+}
+
+std::vector<int> solveByEnumeration(const Adjacency& adj) {
+    const int n = adj.size();
+    if (n > 24) {
+        throw std::range_error("solveByEnumeration: graph too large to enumerate.");
+    }
+
+    std::vector<unsigned> neighborMask(n, 0);
+    for (int u = 0; u < n; u++) {
+        for (int v : adj[u]) neighborMask[u] |= 1u << v;
+    }
+
+    int bestCost = std::numeric_limits<int>::max();
+    unsigned bestSet = 0;
+    for (unsigned twos = 0; twos < (1u << n); twos++) {
+        int cost = 0;
+        for (int u = 0; u < n && cost < bestCost; u++) {
+            if (twos & (1u << u)) {
+                cost += 2;
+            } else if (__builtin_popcount(neighborMask[u] & twos) != 1) {
+                cost += 1;
+            }
+        }
+        if (cost < bestCost) {
+            bestCost = cost;
+            bestSet = twos;
+        }
+    }
+
+    std::vector<char> isTwo(n, false);
+    for (int u = 0; u < n; u++) {
+        isTwo[u] = (bestSet >> u) & 1u;
+    }
+    return labelsFromTwos(adj, isTwo);
+}
@@ -0,0 +1,49 @@
+#ifndef ROMAN_GRAPH_HPP
+#define ROMAN_GRAPH_HPP
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Plain adjacency lists (vertex -> sorted neighbours). This is the common ground
+// between the GA, the BRKGA and the PLI front ends, each of which keeps its own
+// graph class for the search itself.
+using Adjacency = std::vector<std::vector<int>>;
+
+// A label is 0, 1 or 2, so the labellings the solvers keep by the thousand
+// (the GA population, the decoder state) hold one byte per vertex instead of
+// an int: a quarter of the memory, and of the traffic of every copy.
+using Label = uint8_t;
+using Labelling = std::vector<Label>;
+
+Labelling toLabelling(const std::vector<int>& labels);
+std::vector<int> toInts(const Labelling& labels);
+
+// Reads the "n m" + edge list format used by every base in Graph-base.
+// Self-loops and repeated edges are dropped.
+Adjacency readAdjacency(const std::string& path);
+Adjacency buildAdjacency(int numNodes, const std::vector<std::pair<int, int>>& edges);
+
+int countEdges(const Adjacency& adj);
+std::vector<std::pair<int, int>> edgeList(const Adjacency& adj);
+
+// Connected components, each one as a sorted list of vertices.
+std::vector<std::vector<int>> connectedComponents(const Adjacency& adj);
+
+// Subgraph induced by 'vertices'; vertex vertices[i] becomes i.
+Adjacency inducedSubgraph(const Adjacency& adj, const std::vector<int>& vertices);
+
+// Every vertex with label 0 has exactly one neighbour with label 2.
+bool isPerfectRoman(const Adjacency& adj, const std::vector<int>& labels);
+int labelWeight(const std::vector<int>& labels);
+// Over bytes, the sum vectorises to 16 or 32 labels per instruction
+int labelWeight(const Labelling& labels);
+
+// Cheapest labelling once the set of label-2 vertices is fixed: a vertex outside
+// the set gets 0 if it has exactly one neighbour inside, and 1 otherwise.
+std::vector<int> labelsFromTwos(const Adjacency& adj, const std::vector<char>& isTwo);
+
+// Exact solution by enumerating every set of label-2 vertices. Tiny graphs only.
+std::vector<int> solveByEnumeration(const Adjacency& adj);
+
+#endif
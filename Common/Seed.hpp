@@ -0,0 +1,47 @@
+#ifndef SEED_HPP
+#define SEED_HPP
+#include <cstdint>
+#include <string>
+
+// Seeds of a run. One master seed, from --seed or irace, is split into
+// independent streams by a path of indices: trial t of a run, component c of
+// that trial, and so on down to the generators of one solver. A stream
+// depends only on the master seed and its path, never on which thread asks
+// for it or when, so a run with the same seed gives the same results on any
+// number of threads.
+//
+// The mixing is the finaliser of SplitMix64 (Steele, Lea and Flood, 2014), a
+// bijection on 64-bit words whose outputs for nearby inputs look unrelated;
+// a child stream mixes the parent state with the mixed index.
+class SeedSequence {
+    public:
+        explicit SeedSequence(uint64_t seed) : state(mix(seed)) {}
+
+        // Stream 'index' below this one
+        SeedSequence child(uint64_t index) const {
+            return SeedSequence(this->state ^ mix(index + GOLDEN_GAMMA));
+        }
+
+        // Stream named 'name', e.g. the graph of a batch job (FNV-1a of it)
+        SeedSequence child(const std::string& name) const {
+            uint64_t hash = 14695981039346656037ULL;
+            for (unsigned char c : name) hash = (hash ^ c) * 1099511628211ULL;
+            return this->child(hash);
+        }
+
+        // Seed of a generator on this stream, e.g. an std::mt19937 or MTRand
+        unsigned long seed() const { return static_cast<unsigned long>(mix(this->state + GOLDEN_GAMMA)); }
+
+    private:
+        static constexpr uint64_t GOLDEN_GAMMA = 0x9e3779b97f4a7c15ULL;
+
+        uint64_t state;
+
+        static uint64_t mix(uint64_t z) {
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            return z ^ (z >> 31);
+        }
+};
+
+#endif
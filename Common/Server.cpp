@@ -0,0 +1,272 @@
+#include "Server.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+// Fixed pool of worker threads over a queue of jobs
+class WorkerPool {
+    public:
+        explicit WorkerPool(int workers) {
+            const int count = workers > 0 ? workers : std::max(1u, std::thread::hardware_concurrency());
+            for (int i = 0; i < count; i++) this->threads.emplace_back([this]() { this->work(); });
+        }
+
+        ~WorkerPool() { this->finish(); }
+
+        void push(std::function<void()> job) {
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->jobs.push_back(std::move(job));
+            }
+            this->queued.notify_one();
+        }
+
+        // Runs the queued jobs to the end and joins the workers
+        void finish() {
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->closed = true;
+            }
+            this->queued.notify_all();
+            for (std::thread& thread : this->threads) thread.join();
+            this->threads.clear();
+        }
+
+    private:
+        void work() {
+            while (true) {
+                std::function<void()> job;
+                {
+                    std::unique_lock<std::mutex> lock(this->mutex);
+                    this->queued.wait(lock, [this]() { return this->closed || !this->jobs.empty(); });
+                    if (this->jobs.empty()) return;
+                    job = std::move(this->jobs.front());
+                    this->jobs.pop_front();
+                }
+                job();
+            }
+        }
+
+        std::mutex mutex;
+        std::condition_variable queued;
+        std::deque<std::function<void()>> jobs;
+        std::vector<std::thread> threads;
+        bool closed = false;
+};
+
+bool isShutdown(const std::string& line) {
+    std::istringstream stream(line);
+    std::string word;
+    return (stream >> word) && word == "shutdown";
+}
+
+// The response line to a request line, with its newline
+std::string respond(const std::string& line, const RequestHandler& handler) {
+    std::istringstream stream(line);
+    std::string id;
+    stream >> id;
+    std::vector<std::string> words;
+    std::string word;
+    while (stream >> word) words.push_back(word);
+    if (words.size() < 2) {
+        return id + " error expected <id> <seed> <instance> [options]\n";
+    }
+
+    std::string response;
+    try {
+        response = handler(words);
+    } catch (const std::exception& e) {
+        response = std::string("error ") + e.what();
+    }
+
+    for (char& c : response) {
+        if (c == '\n') c = ' ';
+    }
+    return id + " " + response + "\n";
+}
+
+bool sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        const ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        sent += n;
+    }
+    return true;
+}
+
+}
+
+std::string solverSocket() {
+    const char* path = std::getenv("PRD_SOLVER_SOCKET");
+    return path != nullptr && *path != '\0' ? path : DEFAULT_SOCKET;
+}
+
+void serveSocket(const std::string& path, int cores, const RequestHandler& handler) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + path);
+    }
+    std::strcpy(address.sun_path, path.c_str());
+
+    const int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        throw std::runtime_error(std::string("Error creating socket: ") + std::strerror(errno));
+    }
+    unlink(path.c_str());
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(listener, 64) < 0) {
+        close(listener);
+        throw std::runtime_error("Error listening on " + path + ": " + std::strerror(errno));
+    }
+
+    // A connection is read by the loop below and answered by the pool. Its
+    // requests are queued, and at most one worker at a time answers them, in
+    // order. Whichever of the loop and that worker sees it last closes it.
+    struct Connection {
+        int fd;
+        std::string pending;            // received, up to the next newline
+        std::deque<std::string> lines;  // requests not answered yet
+        bool answering = false;
+        bool readClosed = false;
+    };
+    std::mutex connectionsMutex;
+    std::map<int, std::shared_ptr<Connection>> connections;
+    WorkerPool pool(cores);
+
+    // With connectionsMutex held
+    auto release = [&](const std::shared_ptr<Connection>& connection) {
+        close(connection->fd);
+        connections.erase(connection->fd);
+    };
+    auto answer = [&](std::shared_ptr<Connection> connection) {
+        while (true) {
+            std::string line;
+            {
+                std::lock_guard<std::mutex> lock(connectionsMutex);
+                if (connection->lines.empty()) {
+                    connection->answering = false;
+                    if (connection->readClosed) release(connection);
+                    return;
+                }
+                line = std::move(connection->lines.front());
+                connection->lines.pop_front();
+            }
+            if (!sendAll(connection->fd, respond(line, handler))) {
+                std::lock_guard<std::mutex> lock(connectionsMutex);
+                connection->lines.clear();
+            }
+        }
+    };
+    auto stopReading = [&](const std::shared_ptr<Connection>& connection) {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        connection->readClosed = true;
+        if (!connection->answering) release(connection);
+    };
+
+    bool stopping = false;
+    while (!stopping) {
+        std::vector<pollfd> polled{{listener, POLLIN, 0}};
+        std::vector<std::shared_ptr<Connection>> open;
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            for (const auto& entry : connections) {
+                if (entry.second->readClosed) continue;
+                polled.push_back({entry.first, POLLIN, 0});
+                open.push_back(entry.second);
+            }
+        }
+        if (poll(polled.data(), polled.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        if (polled[0].revents & POLLIN) {
+            const int client = accept(listener, nullptr, nullptr);
+            if (client >= 0) {
+                std::shared_ptr<Connection> connection = std::make_shared<Connection>();
+                connection->fd = client;
+                std::lock_guard<std::mutex> lock(connectionsMutex);
+                connections[client] = connection;
+            }
+        }
+
+        for (size_t i = 1; i < polled.size() && !stopping; i++) {
+            if (polled[i].revents == 0) continue;
+            const std::shared_ptr<Connection>& connection = open[i - 1];
+            char buffer[4096];
+            const ssize_t n = recv(connection->fd, buffer, sizeof(buffer), 0);
+            if (n <= 0) {
+                stopReading(connection);
+                continue;
+            }
+            connection->pending.append(buffer, n);
+
+            size_t end;
+            bool received = false;
+            while ((end = connection->pending.find('\n')) != std::string::npos) {
+                std::string line = connection->pending.substr(0, end);
+                connection->pending.erase(0, end + 1);
+                if (isShutdown(line)) {
+                    stopping = true;
+                    break;
+                }
+                if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+                std::lock_guard<std::mutex> lock(connectionsMutex);
+                connection->lines.push_back(std::move(line));
+                received = true;
+            }
+            if (!received) continue;
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            if (!connection->answering) {
+                connection->answering = true;
+                pool.push([&answer, connection]() { answer(connection); });
+            }
+        }
+    }
+
+    // Requests already received are answered; nothing more is read
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        std::vector<std::shared_ptr<Connection>> idle;
+        for (const auto& entry : connections) {
+            entry.second->readClosed = true;
+            if (!entry.second->answering) idle.push_back(entry.second);
+        }
+        for (const std::shared_ptr<Connection>& connection : idle) release(connection);
+    }
+    pool.finish();
+    close(listener);
+    unlink(path.c_str());
+}
+
+void serveStream(std::istream& in, std::ostream& out, int cores, const RequestHandler& handler) {
+    std::mutex outMutex;
+    WorkerPool pool(cores);
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (isShutdown(line)) break;
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+        pool.push([&, line]() {
+            const std::string response = respond(line, handler);
+            std::lock_guard<std::mutex> lock(outMutex);
+            out << response << std::flush;
+        });
+    }
+    pool.finish();
+}
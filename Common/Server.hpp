@@ -0,0 +1,42 @@
+#ifndef SERVER_HPP
+#define SERVER_HPP
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Solver daemon for parameter tuning. Instead of one process per evaluation,
+// a long-lived process keeps the instances in memory and answers evaluation
+// requests, one per line:
+//     request:   <id> <seed> <instance> [options]
+//     response:  <id> <fitness> <time>
+//            or  <id> error <message>
+// where the options are those of the command line, as irace passes them. A
+// line "shutdown" stops the server once the running evaluations are done.
+// Requests come from a Unix domain socket, answered on the same connection,
+// or from stdin, answered on stdout. The evaluations run on a fixed pool of
+// 'cores' worker threads, and requests wait in a queue for a free one. A
+// connection may send any number of requests, which are answered in order;
+// connections are served concurrently, as are the lines of stdin, whose
+// responses come in the order the evaluations finish. Instance paths are
+// resolved against the working directory of the server.
+
+// Default socket of the daemon and of prd-client
+constexpr const char* DEFAULT_SOCKET = "/tmp/prd-solver.sock";
+
+// Socket of prd-client: $PRD_SOLVER_SOCKET, or DEFAULT_SOCKET
+std::string solverSocket();
+
+// One evaluation: the words of the request after the id. Returns the
+// response after the id; an exception becomes an error response. It is
+// called concurrently and must be thread-safe.
+using RequestHandler = std::function<std::string(const std::vector<std::string>& words)>;
+
+// Serves the socket at 'path' until a shutdown request. 0 cores: one per
+// hardware thread.
+void serveSocket(const std::string& path, int cores, const RequestHandler& handler);
+
+// Serves 'in' until its end or a shutdown request
+void serveStream(std::istream& in, std::ostream& out, int cores, const RequestHandler& handler);
+
+#endif
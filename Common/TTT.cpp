@@ -0,0 +1,130 @@
+#include "TTT.hpp"
+#include "Seed.hpp"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+std::ofstream openCsv(const std::string& path, const char* header) {
+    const bool exists = std::filesystem::exists(path);
+    std::ofstream file(path, std::ios::app);
+    if (!file.is_open()) {
+        throw std::runtime_error("Error opening file: " + path);
+    }
+    if (!exists) file << header << "\n";
+    return file;
+}
+
+}
+
+std::vector<TTTRun> runTTT(int runs, unsigned long baseSeed, int threads, const TTTSolver& solver) {
+    std::vector<TTTRun> results(std::max(runs, 0));
+
+    // Runs take very different times, so they are handed out one at a time
+    #ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 1) num_threads(std::max(threads, 1))
+    #endif
+    for (int i = 0; i < runs; i++) {
+        const unsigned long seed = SeedSequence(baseSeed).child(i).seed();
+        results[i] = solver(i, seed);
+        results[i].run = i;
+        results[i].seed = seed;
+    }
+    return results;
+}
+
+std::vector<std::pair<double, double>> tttPlotPoints(const std::vector<TTTRun>& runs) {
+    std::vector<double> times;
+    for (const TTTRun& run : runs) {
+        if (run.time_to_target >= 0) times.push_back(run.time_to_target);
+    }
+    std::sort(times.begin(), times.end());
+
+    std::vector<std::pair<double, double>> points;
+    points.reserve(times.size());
+    for (size_t i = 0; i < times.size(); i++) {
+        points.push_back({times[i], (i + 0.5) / runs.size()});
+    }
+    return points;
+}
+
+bool fitExponential(const std::vector<std::pair<double, double>>& points, double& mu, double& lambda) {
+    const size_t lower = points.size() / 4;
+    const size_t upper = (3 * points.size()) / 4;
+    if (upper >= points.size() || upper == lower) return false;
+
+    // Quantiles of the unit exponential at the two probabilities
+    const double zl = -std::log(1.0 - points[lower].second);
+    const double zu = -std::log(1.0 - points[upper].second);
+    if (zu <= zl) return false;
+
+    lambda = (points[upper].first - points[lower].first) / (zu - zl);
+    mu = points[lower].first - lambda * zl;
+    return lambda > 0;
+}
+
+void writeTTTRuns(const std::string& path, const std::string& graphName, const std::string& algorithm,
+    int target, const std::vector<TTTRun>& runs) {
+    std::ofstream file = openCsv(path, "graph_name,algorithm,target,run,seed,fitness_value,elapsed_time(seconds),time_to_target");
+    for (const TTTRun& run : runs) {
+        file << graphName << "," << algorithm << "," << target << "," << run.run << "," << run.seed << ","
+             << run.fitness << "," << run.elapsed_time << "," << run.time_to_target << "\n";
+    }
+}
+
+void writeTTTPlot(const std::string& path, const std::string& graphName, const std::string& algorithm,
+    int target, const std::vector<TTTRun>& runs) {
+    const std::vector<std::pair<double, double>> points = tttPlotPoints(runs);
+    double mu = 0.0, lambda = 0.0;
+    const bool fitted = fitExponential(points, mu, lambda);
+
+    std::ofstream file = openCsv(path, "graph_name,algorithm,target,time_to_target,probability,exponential");
+    for (const auto& [time, probability] : points) {
+        file << graphName << "," << algorithm << "," << target << "," << time << "," << probability << ",";
+        if (fitted) file << std::max(0.0, 1.0 - std::exp(-(time - mu) / lambda));
+        file << "\n";
+    }
+}
+
+std::string tttPath(const std::string& output, const std::string& suffix) {
+    std::filesystem::path path(output);
+    const std::string extension = path.has_extension() ? path.extension().string() : ".csv";
+    path.replace_filename(path.stem().string() + suffix + extension);
+    return path.string();
+}
+
+void printTTTSummary(std::ostream& os, int target, const std::vector<TTTRun>& runs) {
+    const std::vector<std::pair<double, double>> points = tttPlotPoints(runs);
+    os << "TTT (target " << target << "): " << points.size() << " of " << runs.size() << " runs reached the target";
+    if (!points.empty()) {
+        double total = 0.0;
+        for (const auto& point : points) total += point.first;
+        os << " (mean " << total / points.size() << " s, median " << points[points.size() / 2].first << " s)";
+    }
+    os << std::endl;
+}
+
+std::vector<int> parseTargets(const std::string& list) {
+    const std::invalid_argument invalid("invalid target list " + list + " (weights separated by commas)");
+    std::vector<int> targets;
+    std::istringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        size_t end = 0;
+        try {
+            targets.push_back(std::stoi(item, &end));
+        } catch (const std::exception&) {
+            throw invalid;
+        }
+        if (end != item.size()) throw invalid;
+    }
+    if (targets.empty()) throw invalid;
+    return targets;
+}
@@ -0,0 +1,55 @@
+#ifndef TTT_HPP
+#define TTT_HPP
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Time-to-target experiments: a stochastic solver is run many times on one
+// instance with independent seeds, and each run records the first time its
+// best weight reached a target. The sorted times give the empirical runtime
+// distribution that TTT plots are drawn from.
+struct TTTRun {
+    int run = 0;
+    unsigned long seed = 0;
+    int fitness = -1;
+    double elapsed_time = -1;
+    double time_to_target = -1;     // -1 when the run never reached the target
+};
+
+// One run of the solver under test. It is called concurrently and must be
+// thread-safe.
+using TTTSolver = std::function<TTTRun(int run, unsigned long seed)>;
+
+// Runs 'runs' independent runs on 'threads' threads; run i gets the seed of
+// stream i of baseSeed (see Seed.hpp), whichever thread runs it.
+std::vector<TTTRun> runTTT(int runs, unsigned long baseSeed, int threads, const TTTSolver& solver);
+
+// Points (t_i, p_i) of the empirical distribution: the times of the runs that
+// reached the target in increasing order, with p_i = (i - 0.5) / runs. Runs
+// that missed the target count in the denominator only.
+std::vector<std::pair<double, double>> tttPlotPoints(const std::vector<TTTRun>& runs);
+
+// Shifted exponential 1 - exp(-(t - mu) / lambda) fitted through the first and
+// third quartiles of the points, as in the usual TTT plots. Returns false when
+// there are too few points.
+bool fitExponential(const std::vector<std::pair<double, double>>& points, double& mu, double& lambda);
+
+// Appends one row per run, and one row per plot point together with the
+// fitted exponential, to CSV files that get a header when they are created.
+void writeTTTRuns(const std::string& path, const std::string& graphName, const std::string& algorithm,
+    int target, const std::vector<TTTRun>& runs);
+void writeTTTPlot(const std::string& path, const std::string& graphName, const std::string& algorithm,
+    int target, const std::vector<TTTRun>& runs);
+
+// "results.csv" -> "results_ttt.csv" for the suffix "_ttt"
+std::string tttPath(const std::string& output, const std::string& suffix);
+
+void printTTTSummary(std::ostream& os, int target, const std::vector<TTTRun>& runs);
+
+// The weights of --target: "120", or "130,125,120" for one experiment at
+// each of them. Throws on anything else.
+std::vector<int> parseTargets(const std::string& list);
+
+#endif
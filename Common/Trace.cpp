@@ -0,0 +1,85 @@
+#include "Trace.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+
+TraceRing::TraceRing(size_t capacity) {
+    size_t size = 1;
+    while (size < capacity) size <<= 1;
+    this->slots.resize(size);
+    this->mask = size - 1;
+}
+
+bool TraceRing::push(const TracePoint& point) {
+    const size_t tail = this->tail.load(std::memory_order_relaxed);
+    if (tail - this->head.load(std::memory_order_acquire) == this->slots.size()) return false;
+    this->slots[tail & this->mask] = point;
+    this->tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool TraceRing::pop(TracePoint& point) {
+    const size_t head = this->head.load(std::memory_order_relaxed);
+    if (head == this->tail.load(std::memory_order_acquire)) return false;
+    point = this->slots[head & this->mask];
+    this->head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+namespace {
+
+template <typename T>
+void writeRaw(std::ofstream& file, T value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+}
+
+TraceSink::TraceSink(const std::string& path, int run, int offset, size_t capacity)
+    : ring(capacity), run(run), offset(offset), begin(std::chrono::steady_clock::now()) {
+    const std::filesystem::path filePath(path);
+    this->binary = filePath.extension() == ".bin";
+    const bool exists = std::filesystem::exists(filePath);
+
+    this->file.open(path, std::ios::app | (this->binary ? std::ios::binary : std::ios::openmode()));
+    if (!this->file.is_open()) {
+        throw std::runtime_error("Error opening file: " + path);
+    }
+    if (!this->binary && !exists) {
+        this->file << "run,time(seconds),generation,fitness_value,diversity\n";
+    }
+
+    this->writer = std::thread([this]() {
+        while (!this->stopping.load(std::memory_order_acquire)) {
+            this->drain();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    });
+}
+
+TraceSink::~TraceSink() {
+    this->stopping.store(true, std::memory_order_release);
+    this->writer.join();
+    this->drain();
+    if (this->dropped > 0) {
+        std::cerr << "Trace: " << this->dropped << " points of run " << this->run << " dropped (ring full)" << std::endl;
+    }
+}
+
+void TraceSink::drain() {
+    TracePoint point;
+    while (this->ring.pop(point)) {
+        if (this->binary) {
+            writeRaw<int32_t>(this->file, this->run);
+            writeRaw<double>(this->file, point.time);
+            writeRaw<int32_t>(this->file, point.generation);
+            writeRaw<int32_t>(this->file, point.fitness);
+            writeRaw<double>(this->file, point.diversity);
+        } else {
+            this->file << this->run << "," << point.time << "," << point.generation << ","
+                       << point.fitness << "," << point.diversity << "\n";
+        }
+    }
+    this->file.flush();
+}
@@ -0,0 +1,75 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Convergence traces: one point per improvement of the incumbent, so that the
+// anytime profile of a run can be plotted without rerunning it with DEBUG
+// output.
+struct TracePoint {
+    double time;        // seconds since the run started
+    int generation;
+    int fitness;
+    double diversity;   // 0 when the whole population equals the best individual
+};
+
+// Single-producer single-consumer ring buffer. The producer is the search
+// loop and the consumer the writer thread of a TraceSink; neither ever blocks.
+class TraceRing {
+    public:
+        explicit TraceRing(size_t capacity);    // rounded up to a power of two
+
+        bool push(const TracePoint& point);     // false when the ring is full
+        bool pop(TracePoint& point);            // false when the ring is empty
+
+    private:
+        std::vector<TracePoint> slots;
+        size_t mask;
+        alignas(64) std::atomic<size_t> head{0};    // next slot to read
+        alignas(64) std::atomic<size_t> tail{0};    // next slot to write
+};
+
+// Records the trace of one run. record() only takes a timestamp and pushes
+// to the ring; a background thread drains it to 'path' and the destructor
+// flushes whatever is left. A path ending in ".bin" gets packed binary
+// records (int32 run, float64 time, int32 generation, int32 fitness,
+// float64 diversity; little endian, 28 bytes each), any other path gets CSV
+// rows. Both are appended to, so several runs can share a file as long as
+// they do not trace at the same time. 'offset' is added to every fitness, for
+// weight fixed outside the search such as by the reductions.
+class TraceSink {
+    public:
+        TraceSink(const std::string& path, int run, int offset = 0, size_t capacity = 1 << 12);
+        ~TraceSink();
+
+        TraceSink(const TraceSink&) = delete;
+        TraceSink& operator=(const TraceSink&) = delete;
+
+        // Restarts the clock; call when the search starts.
+        void restart() { this->begin = std::chrono::steady_clock::now(); }
+
+        void record(int generation, int fitness, double diversity) {
+            const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - this->begin).count();
+            if (!this->ring.push({time, generation, fitness + this->offset, diversity})) this->dropped++;
+        }
+
+    private:
+        TraceRing ring;
+        std::ofstream file;
+        bool binary;
+        int run;
+        int offset;
+        long long dropped = 0;
+        std::chrono::steady_clock::time_point begin;
+        std::atomic<bool> stopping{false};
+        std::thread writer;
+
+        void drain();
+};
+
+#endif
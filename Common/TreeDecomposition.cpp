@@ -0,0 +1,330 @@
+#include "TreeDecomposition.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+
+// Vertex states in a bag
+constexpr int N0 = 0, N1 = 1, N2 = 2, IN = 3;
+constexpr int INF = std::numeric_limits<int>::max() / 2;
+
+inline int digit(uint32_t index, int position) { return (index >> (2 * position)) & 3; }
+
+// Largest minimum degree over the subgraphs, by repeatedly removing a vertex of
+// minimum degree; the buckets keep stale entries, skipped when popped
+int degeneracy(const Adjacency& adj) {
+    const int n = adj.size();
+    std::vector<int> degree(n);
+    int maxDegree = 0;
+    for (int u = 0; u < n; u++) {
+        degree[u] = adj[u].size();
+        maxDegree = std::max(maxDegree, degree[u]);
+    }
+    std::vector<std::vector<int>> buckets(maxDegree + 1);
+    for (int u = 0; u < n; u++) buckets[degree[u]].push_back(u);
+
+    std::vector<char> removed(n, false);
+    int result = 0;
+    int low = 0;
+    for (int count = 0; count < n;) {
+        if (buckets[low].empty()) {
+            low++;
+            continue;
+        }
+        const int u = buckets[low].back();
+        buckets[low].pop_back();
+        if (removed[u] || degree[u] != low) continue;
+
+        removed[u] = true;
+        count++;
+        result = std::max(result, low);
+        for (int v : adj[u]) {
+            if (!removed[v]) buckets[--degree[v]].push_back(v);
+        }
+        low = std::max(0, low - 1);
+    }
+    return result;
+}
+
+}
+
+TreeDecomposition::TreeDecomposition(const Adjacency& adj, int widthLimit, double timeLimit)
+    : adj(adj), widthLimit(widthLimit) {
+    if (degeneracy(adj) > widthLimit) return;
+    if (timeLimit < std::numeric_limits<double>::infinity()) {
+        this->limited = true;
+        this->deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(std::max(timeLimit, 0.0)));
+    }
+
+    bool found = this->eliminateByMinDegree();
+    if (!found && static_cast<int>(adj.size()) <= MIN_FILL_LIMIT) {
+        found = this->eliminateByMinFill();
+    }
+    if (found) this->buildTree();
+}
+
+bool TreeDecomposition::eliminateByMinDegree() {
+    const int n = this->adj.size();
+    std::vector<std::set<int>> fill(n);
+    for (int u = 0; u < n; u++) fill[u].insert(this->adj[u].begin(), this->adj[u].end());
+
+    std::set<std::pair<int, int>> queue;
+    for (int u = 0; u < n; u++) queue.insert({fill[u].size(), u});
+
+    this->order.clear();
+    this->bags.assign(n, {});
+    int width = 0;
+    while (!queue.empty()) {
+        const int v = queue.begin()->second;
+        queue.erase(queue.begin());
+        if (static_cast<int>(fill[v].size()) > this->widthLimit || this->expired()) return false;
+        width = std::max(width, static_cast<int>(fill[v].size()));
+
+        std::vector<int> neighbors(fill[v].begin(), fill[v].end());
+        this->order.push_back(v);
+        this->bags[v] = {v};
+        this->bags[v].insert(this->bags[v].end(), neighbors.begin(), neighbors.end());
+
+        // The neighbours of v become a clique
+        for (int u : neighbors) queue.erase({fill[u].size(), u});
+        for (int u : neighbors) {
+            fill[u].erase(v);
+            for (int w : neighbors) {
+                if (w != u) fill[u].insert(w);
+            }
+        }
+        for (int u : neighbors) queue.insert({fill[u].size(), u});
+    }
+    this->treewidth = width;
+    return true;
+}
+
+bool TreeDecomposition::eliminateByMinFill() {
+    const int n = this->adj.size();
+    std::vector<std::set<int>> fill(n);
+    for (int u = 0; u < n; u++) fill[u].insert(this->adj[u].begin(), this->adj[u].end());
+
+    // Number of edges missing for N(u) to be a clique
+    auto missing = [&](int u) {
+        int count = 0;
+        for (auto a = fill[u].begin(); a != fill[u].end(); ++a) {
+            for (auto b = std::next(a); b != fill[u].end(); ++b) {
+                if (!fill[*a].count(*b)) count++;
+            }
+        }
+        return count;
+    };
+
+    std::vector<int> cost(n);
+    std::set<std::tuple<int, int, int>> queue;
+    for (int u = 0; u < n; u++) {
+        if (this->expired()) return false;
+        cost[u] = missing(u);
+        queue.insert({cost[u], fill[u].size(), u});
+    }
+
+    this->order.clear();
+    this->bags.assign(n, {});
+    int width = 0;
+    while (!queue.empty()) {
+        const int v = std::get<2>(*queue.begin());
+        queue.erase(queue.begin());
+        if (static_cast<int>(fill[v].size()) > this->widthLimit || this->expired()) return false;
+        width = std::max(width, static_cast<int>(fill[v].size()));
+
+        std::vector<int> neighbors(fill[v].begin(), fill[v].end());
+        this->order.push_back(v);
+        this->bags[v] = {v};
+        this->bags[v].insert(this->bags[v].end(), neighbors.begin(), neighbors.end());
+
+        // Only vertices within distance 2 of v can see their fill change
+        std::set<int> touched;
+        for (int u : neighbors) {
+            touched.insert(u);
+            touched.insert(fill[u].begin(), fill[u].end());
+        }
+        touched.erase(v);
+        for (int u : touched) queue.erase({cost[u], fill[u].size(), u});
+
+        for (int u : neighbors) {
+            fill[u].erase(v);
+            for (int w : neighbors) {
+                if (w != u) fill[u].insert(w);
+            }
+        }
+        for (int u : touched) {
+            cost[u] = missing(u);
+            queue.insert({cost[u], fill[u].size(), u});
+        }
+    }
+    this->treewidth = width;
+    return true;
+}
+
+void TreeDecomposition::buildTree() {
+    const int n = this->adj.size();
+    std::vector<int> position(n);
+    for (int i = 0; i < n; i++) position[this->order[i]] = i;
+
+    this->parent.assign(n, -1);
+    this->children.assign(n, {});
+    for (int v : this->order) {
+        int first = -1;
+        for (size_t i = 1; i < this->bags[v].size(); i++) {
+            const int u = this->bags[v][i];
+            if (first == -1 || position[u] < position[first]) first = u;
+        }
+        this->parent[v] = first;
+        if (first != -1) this->children[first].push_back(v);
+    }
+}
+
+double TreeDecomposition::estimatedWork() const {
+    // A join enumerates, for every table entry, the compatible counts of the child
+    double work = 0.0;
+    for (int v : this->order) {
+        work += (this->children[v].size() + 1) * std::pow(10.0, this->bags[v].size());
+    }
+    return work;
+}
+
+double TreeDecomposition::estimatedMemory() const {
+    double memory = 0.0;
+    for (int v : this->order) {
+        const double entries = std::pow(4.0, this->bags[v].size());
+        memory += this->children[v].size() * entries * sizeof(uint64_t) + entries / 4 * sizeof(uint32_t);
+    }
+    return memory;
+}
+
+bool TreeDecomposition::isTractable() const {
+    return this->treewidth != -1 && this->estimatedWork() <= WORK_LIMIT && this->estimatedMemory() <= MEMORY_LIMIT;
+}
+
+std::vector<int> TreeDecomposition::solve() const {
+    if (this->treewidth == -1) {
+        throw std::logic_error("TreeDecomposition::solve: no decomposition within the width limit.");
+    }
+    const int n = this->adj.size();
+
+    std::vector<std::vector<int>> message(n);                    // table passed to the parent
+    std::vector<std::vector<uint32_t>> forgetArg(n);             // message entry -> bag entry
+    std::vector<std::vector<std::vector<uint64_t>>> joinArg(n);  // per child: (previous, message)
+
+    for (int v : this->order) {
+        const std::vector<int>& bag = this->bags[v];
+        const int k = bag.size();
+        const uint32_t size = 1u << (2 * k);
+
+        // Nothing counted yet: every vertex is either in S or has count 0
+        std::vector<int> table(size, INF);
+        for (uint32_t mask = 0; mask < (1u << k); mask++) {
+            uint32_t index = 0;
+            for (int i = 0; i < k; i++) {
+                if (mask & (1u << i)) index |= uint32_t(IN) << (2 * i);
+            }
+            table[index] = 0;
+        }
+
+        // Join the message of every child; its bag minus the child sits inside this bag
+        for (int c : this->children[v]) {
+            const std::vector<int>& childBag = this->bags[c];
+            std::vector<int> positions;
+            for (size_t j = 1; j < childBag.size(); j++) {
+                positions.push_back(std::find(bag.begin(), bag.end(), childBag[j]) - bag.begin());
+            }
+            const int s = positions.size();
+            const std::vector<int>& incoming = message[c];
+
+            std::vector<int> joined(size, INF);
+            std::vector<uint64_t> arg(size, 0);
+            std::vector<int> free(s);
+            std::vector<int> counts(s);
+            for (uint32_t a = 0; a < size; a++) {
+                if (table[a] >= INF) continue;
+
+                // Child vertices in S must be in S here; the others take a count 0..2
+                uint32_t base = 0;
+                int f = 0;
+                for (int j = 0; j < s; j++) {
+                    if (digit(a, positions[j]) == IN) base |= uint32_t(IN) << (2 * j);
+                    else free[f++] = j;
+                }
+                std::fill(counts.begin(), counts.begin() + f, 0);
+                while (true) {
+                    uint32_t b = base;
+                    uint32_t p = a;
+                    for (int t = 0; t < f; t++) {
+                        const int j = free[t];
+                        b |= uint32_t(counts[t]) << (2 * j);
+                        const int sum = std::min(digit(a, positions[j]) + counts[t], N2);
+                        p = (p & ~(uint32_t(3) << (2 * positions[j]))) | (uint32_t(sum) << (2 * positions[j]));
+                    }
+                    if (incoming[b] < INF && table[a] + incoming[b] < joined[p]) {
+                        joined[p] = table[a] + incoming[b];
+                        arg[p] = (uint64_t(a) << 32) | b;
+                    }
+
+                    int t = 0;
+                    while (t < f && counts[t] == N2) counts[t++] = N0;
+                    if (t == f) break;
+                    counts[t]++;
+                }
+            }
+            table.swap(joined);
+            joinArg[v].push_back(std::move(arg));
+            std::vector<int>().swap(message[c]);
+        }
+
+        // Forget v: count its edges to the rest of the bag, then charge its cost
+        std::vector<char> adjacent(k, false);
+        for (int i = 1; i < k; i++) {
+            adjacent[i] = std::binary_search(this->adj[v].begin(), this->adj[v].end(), bag[i]);
+        }
+        message[v].assign(size >> 2, INF);
+        forgetArg[v].assign(size >> 2, 0);
+        for (uint32_t q = 0; q < size; q++) {
+            if (table[q] >= INF) continue;
+            const int x = digit(q, 0);
+            int own = x;
+            uint32_t rest = q >> 2;
+            for (int i = 1; i < k; i++) {
+                if (!adjacent[i]) continue;
+                const int d = digit(rest, i - 1);
+                if (x == IN && d != IN) {
+                    rest = (rest & ~(uint32_t(3) << (2 * (i - 1)))) | (uint32_t(std::min(d + 1, N2)) << (2 * (i - 1)));
+                } else if (d == IN && x != IN) {
+                    own = std::min(own + 1, N2);
+                }
+            }
+            const int cost = (x == IN) ? 2 : (own == N1 ? 0 : 1);
+            if (table[q] + cost < message[v][rest]) {
+                message[v][rest] = table[q] + cost;
+                forgetArg[v][rest] = q;
+            }
+        }
+    }
+
+    // Top-down: the roots forget into an empty bag, whose only entry is 0
+    std::vector<uint32_t> state(n, 0);
+    for (int v : this->order) {
+        if (this->parent[v] == -1) state[v] = forgetArg[v][0];
+    }
+    std::vector<char> isTwo(n, false);
+    for (auto it = this->order.rbegin(); it != this->order.rend(); ++it) {
+        const int v = *it;
+        uint32_t p = state[v];
+        isTwo[v] = digit(p, 0) == IN;
+        for (int i = this->children[v].size() - 1; i >= 0; i--) {
+            const uint64_t packed = joinArg[v][i][p];
+            state[this->children[v][i]] = forgetArg[this->children[v][i]][static_cast<uint32_t>(packed)];
+            p = static_cast<uint32_t>(packed >> 32);
+        }
+    }
+    return labelsFromTwos(this->adj, isTwo);
+}
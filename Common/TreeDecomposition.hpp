@@ -0,0 +1,64 @@
+#ifndef TREE_DECOMPOSITION_HPP
+#define TREE_DECOMPOSITION_HPP
+#include "RomanGraph.hpp"
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+// Exact solver for graphs of small treewidth.
+//
+// The decomposition comes from an elimination ordering (min-degree, or
+// min-fill when min-degree is too wide on a small graph). A graph whose
+// degeneracy exceeds the width limit has a larger treewidth too, and is turned
+// down before either ordering is tried. Eliminating v gives
+// the bag {v} + its later neighbours in the filled graph, and the parent of
+// that bag is the bag of the first of those neighbours to be eliminated.
+//
+// The DP runs over the bags in elimination order. Each bag vertex is in one of
+// four states, two bits each: not in S with 0, 1 or 2+ neighbours in S counted
+// so far, or in S. An edge is counted when its first endpoint is forgotten,
+// which is also when that endpoint's cost is charged; joining two tables adds
+// the counts, capped at 2. The argmin of every forget and join step is kept,
+// so the optimal labelling is rebuilt top-down afterwards.
+class TreeDecomposition {
+    public:
+        static constexpr int MAX_WIDTH = 6;
+        static constexpr int MIN_FILL_LIMIT = 1000;        // vertices
+        static constexpr double WORK_LIMIT = 2e9;          // join steps
+        static constexpr double MEMORY_LIMIT = 1 << 28;    // bytes of argmin tables
+
+        // The orderings give up once 'timeLimit' seconds have passed
+        explicit TreeDecomposition(const Adjacency& adj, int widthLimit = MAX_WIDTH,
+            double timeLimit = std::numeric_limits<double>::infinity());
+        ~TreeDecomposition() = default;
+
+        // Width of the decomposition, or -1 when every ordering tried went over the limit
+        int width() const { return this->treewidth; }
+
+        // True when the DP fits the width, work and memory limits
+        bool isTractable() const;
+
+        // Optimal labelling; only call it when isTractable()
+        std::vector<int> solve() const;
+
+    private:
+        Adjacency adj;
+        int widthLimit;
+        int treewidth = -1;
+        std::vector<int> order;                 // elimination order
+        std::vector<std::vector<int>> bags;     // bags[v] = {v} + later neighbours
+        std::vector<int> parent;                // -1 for the root of each tree
+        std::vector<std::vector<int>> children;
+        bool limited = false;
+        std::chrono::steady_clock::time_point deadline;
+
+        bool expired() const { return this->limited && std::chrono::steady_clock::now() > this->deadline; }
+
+        bool eliminateByMinDegree();
+        bool eliminateByMinFill();
+        void buildTree();
+        double estimatedWork() const;
+        double estimatedMemory() const;
+};
+
+#endif
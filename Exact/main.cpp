@@ -0,0 +1,135 @@
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <memory>
+#include "../Common/RomanGraph.hpp"
+#include "../Common/Reduction.hpp"
+#include "../Common/ExactSolver.hpp"
+
+namespace fs = std::filesystem;
+
+// Mesmo esquema de saída do PI/main.cpp, para que os resultados possam ser
+// comparados diretamente com os do Gurobi, do GA e do BRKGA
+struct Result {
+    std::string graph_name = "";
+    int node_count = -1;
+    int edge_count = -1;
+    float graph_density = -1;
+    int objValue = -1;
+    double elapsed_time = -1;
+    bool isOptimal = false;
+};
+
+struct Parameters {
+    std::string file_path;
+    std::string output_file = "results.csv";
+    bool reduce = false;
+    double timeLimit = 900;
+};
+
+Parameters parse_args(int argc, char* argv[]);
+void ensure_csv_header(const std::string &filename);
+void write_result_to_csv(const std::string &filename, const Result &result);
+Result readGraphAndSolve(const Parameters& params);
+
+
+int main(int argc, char *argv[]) {
+
+    Parameters params = parse_args(argc, argv);
+    ensure_csv_header(params.output_file);
+
+    Result res = readGraphAndSolve(params);
+    write_result_to_csv(params.output_file, res);
+
+    return 0;
+}
+
+Parameters parse_args(int argc, char* argv[]){
+    Parameters res;
+    if(argc < 3){
+        std::cerr << "Usage: " << argv[0] << " <graph_file> <output_file> [options]\n"
+                  << "Options:\n"
+                  << "  --time-limit SECONDS\n"
+                  << "  --reduce\n";
+        exit(1);
+    }
+
+    res.file_path = argv[1];
+    res.output_file = argv[2];
+
+    for(int i = 3; i < argc; i++){
+        std::string arg = argv[i];
+        if(arg == "--time-limit" && i + 1 < argc){
+            res.timeLimit = std::stod(argv[++i]);
+        }else if(arg == "--reduce"){
+            res.reduce = true;
+        }else{
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            exit(1);
+        }
+    }
+
+    return res;
+}
+
+void ensure_csv_header(const std::string &filename) {
+    bool file_exists = std::filesystem::exists(filename);
+    std::ofstream file;
+    if (!file_exists) {
+        file.open(filename);
+        file << "graph_name,graph_order,graph_size,density,objective_value,elapsed_time(seconds), optimal_value\n";
+        file.close();
+    } 
+}
+
+void write_result_to_csv(const std::string &filename, const Result &result) {
+    std::ofstream file(filename, std::ios::app);
+    file << result.graph_name << "," << result.node_count << ","
+         << result.edge_count << "," << result.graph_density << "," << result.objValue << ","
+         << result.elapsed_time << "," << result.isOptimal << "\n"; 
+    file.close();
+}
+
+Result readGraphAndSolve(const Parameters& params) {
+
+    Result res;
+
+    Adjacency adj = readAdjacency(params.file_path);
+    const int num_vertex = adj.size();
+    const int num_edges = countEdges(adj);
+
+    res.node_count = num_vertex;
+    res.edge_count = num_edges;
+    res.graph_name = fs::path (params.file_path).stem().string();
+    res.graph_density = static_cast<float>(2 * num_edges) / (num_vertex * (num_vertex - 1));
+
+    auto begin = std::chrono::high_resolution_clock::now();
+
+    // opt(G) = opt(kernel) + peso fixado pelas reduções
+    std::unique_ptr<Reduction> reduction;
+    if(params.reduce){
+        reduction = std::make_unique<Reduction>(adj);
+        reduction->apply();
+        reduction->printSummary(std::cout);
+    }
+
+    ExactSolver solver(params.reduce ? reduction->kernel() : adj);
+    double remaining = params.timeLimit - std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count();
+    solver.solve(remaining);
+
+    std::vector<int> labels = params.reduce ? reduction->lift(solver.labels()) : solver.labels();
+    if(!isPerfectRoman(adj, labels)){
+        throw std::runtime_error("Solution is not a perfect Roman dominating function: " + params.file_path);
+    }
+
+    res.objValue = labelWeight(labels);
+    res.isOptimal = solver.isOptimal();
+    res.elapsed_time = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count();
+
+    std::cout << res.graph_name << ": weight " << res.objValue
+              << (res.isOptimal ? " (optimal)" : " (time limit)")
+              << ", " << solver.nodeCount() << " nodes, " << res.elapsed_time << " s" << std::endl;
+
+    return res;
+}
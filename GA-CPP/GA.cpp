@@ -1,299 +1,514 @@
-#include "GA.hpp"
-#include "Solution.hpp"
-
-// ok atilio!
-GeneticAlgorithm::GeneticAlgorithm(Graph* g, int popFactor, int tournSize, 
-    int stagnant,float mutRate, float eliSize, int maxGenerations) : gen(std::random_device{}()),dis(0.1, 1.0), disInt(0, 1) {
-
-    this->mutationRate = mutRate;
-    this->populationSize = g->numNodes / popFactor;
-    this->elitismSize = static_cast<std::size_t>(std::floor(this->populationSize * eliSize));
-    this->maxGenerations = maxGenerations;
-    this->maxStagnant = stagnant;
-    this->tournamentSize = tournSize;
-
-    this->g = g;
-    this->prd = new PRD(this->g);
-    this->population = this->initializePopulation();
-}
-
-// ok atilio
-GeneticAlgorithm::~GeneticAlgorithm(){
-    delete this->prd;
-    for(Solution* s: population){
-        delete s;
-    }
-    population.clear();
-}
-
-Result GeneticAlgorithm::gaFlow() {
-
-    std::vector<Solution*> currentPop = this->population;  
-
-    Result res = Result(
-        this->g->graphName,
-        this->g->numNodes, 
-        this->g->numEdges,
-        static_cast<float>(2 * this->g->numEdges) / (this->g->numNodes * (this->g->numNodes - 1)),
-        std::numeric_limits<int>::max(),
-        0.0
-    );
-
-    const double TIME_LIMIT = 900.0;
-
-    auto begin = std::chrono::high_resolution_clock::now();
-
-    int gen = 0;
-    for(int i = 0; i < this->maxGenerations && gen < this->maxStagnant; i++){
-
-        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
-            std::chrono::high_resolution_clock::now() - begin
-        ).count();
-
-        if (elapsed > TIME_LIMIT) {
-            res.elapsed_time = TIME_LIMIT;
-            this->population = currentPop;
-            return res;
-        }
-        // Selection
-        std::vector<std::pair<Solution*, Solution*>> select = GeneticAlgorithm::tournamentSelection(currentPop);
-
-        // Crossover
-        std::vector<Solution*> newPop  = GeneticAlgorithm::onePointCrossover(select);
-
-        // Mutation
-        GeneticAlgorithm::randomMutation(newPop);
-
-        // Elitism
-        currentPop = GeneticAlgorithm::defaultElitism(currentPop, newPop);
-
-        if(currentPop[0]->fitness < res.fitness) {
-            res.fitness = currentPop[0]->fitness;
-            gen = 0;
-        }else {
-            gen++;
-        }
-    }
-
-    auto end = std::chrono::high_resolution_clock::now();
-    res.elapsed_time = std::chrono::duration<double>(end - begin).count();
-
-    this->population = currentPop;
-    
-    return res;
-}
-
-// OPERATORS
-
-// ok atilio
-// Selection
-std::vector<std::pair<Solution*, Solution*>> GeneticAlgorithm::tournamentSelection(std::vector<Solution*> population) {
-    std::vector<std::pair<Solution*, Solution*>> selectedPairs;
-    for(int i = 0; i < std::ceil(population.size()) / 2; i++){
-        std::vector<Solution*> auxiliary = population;
-        
-        // Embaralha o vetor
-        std::shuffle(auxiliary.begin(), auxiliary.end(), gen);
-    
-        Solution* first = GeneticAlgorithm::findMinimal(auxiliary);
-        
-        Solution* second = GeneticAlgorithm::findMinimal(auxiliary);
-        
-    
-        selectedPairs.push_back(std::make_pair(first, second));
-    }
-    return selectedPairs;
-}
-
-// Crossover
-std::vector<Solution*> GeneticAlgorithm::onePointCrossover(std::vector<std::pair<Solution*, Solution*>> pop) {
-
-    std::vector<Solution*> result;
-
-    for(int i = 0; i < pop.size(); i++){
-
-        std::pair<Solution*, Solution*> pair = pop[i];
-
-        Solution* dad = pair.first;
-        Solution* mom = pair.second;
-        
-        int solutionLength = this->g->numNodes;
-        int randomIndex = dis(gen);
-        
-        std::vector<int> firstChild;
-        std::vector<int> secondChild; 
-
-        for(int i = 0; i < randomIndex; i++){
-            firstChild.push_back(dad->solution[i]);
-            secondChild.push_back(mom->solution[i]);
-        }
-
-        for(int i = randomIndex; i < solutionLength; i++){
-            firstChild.push_back(mom->solution[i]);
-            secondChild.push_back(dad->solution[i]);
-        }
-
-        if(this->populationSize % 2 == 1 && i+1 == pop.size()){
-            Solution* f = new Solution(firstChild, this->prd);
-            Solution* s = new Solution(secondChild, this->prd);
-
-            if(f->fitness < s->fitness){
-                result.push_back(f);
-                delete s;
-            }else{
-                result.push_back(s);
-                delete f;
-            }
-        }else{
-            result.push_back(new Solution(firstChild, this->prd));
-            result.push_back(new Solution(secondChild, this->prd));
-        }
-    }
-    return result;
-}
-
-
-// ok atilio
-// Mutation
-void GeneticAlgorithm::randomMutation(std::vector<Solution*>& pop){
-    for (Solution*& sol : pop) {
-        bool changed = false;
-        // For every gen, look if have mutation
-        for (int k = 0; k < sol->solution.size(); k++) {
-            if (dis(gen) < this->mutationRate) {
-                sol->solution[k] = disInt(gen) * 2;
-                changed = true;
-            }
-        }
-        // Solution changed, recalculation required.
-        if (changed) {
-            sol = this->changeSolution(sol);
-        }
-    }
-}
-
-//Elitism
-std::vector<Solution*> GeneticAlgorithm::defaultElitism(std::vector<Solution*>& current, std::vector<Solution*>& newPop) {
-
-    std::vector<Solution*> result;
-    
-    // Sort the solution vectors
-    std::sort(current.begin(), current.end(), [](Solution* a, Solution* b) { return *a < *b;}); 
-    std::sort(newPop.begin(), newPop.end(), [](Solution* a, Solution* b) { return *a < *b;});
-
-    for(int i = 0; i < current.size(); i++){ 
-            if(i < this->elitismSize){
-                result.push_back(current[i]); 
-            }else{
-                delete current[i];
-            }
-        }
-    
-    // Copy the best features from this generagtion and free up the rest of memory.
-    int res = newPop.size() - this->elitismSize;
-    
-    for(int i = 0; i < newPop.size(); i++){ 
-        if(i < res){
-            result.push_back(newPop[i]);
-        }else {
-            delete newPop[i];
-        }  
-    } 
-    // Sort the result to get best solution on first position
-    std::sort(result.begin(), result.end(), [](Solution* a, Solution* b) { return *a < *b;}); 
-    return result;
-}
-
-// Auxiliary functions
-
-// ok atilio
-Solution* GeneticAlgorithm::findMinimal(std::vector<Solution*>& preSelected) {
-    Solution* minimal = preSelected[0];
-    int indexToRemove = 0;
-    for(int i = 1; i < this->tournamentSize; i++){
-        if(*preSelected[i] < *minimal){
-            minimal = preSelected[i];
-            indexToRemove = i;
-        }
-    }
-    preSelected.erase(preSelected.begin() + indexToRemove);
-    return minimal;
-}
-
-// ok atilio
-Solution* GeneticAlgorithm::changeSolution(Solution* element){
-    Solution* aux = new Solution(element->solution, this->prd);
-    delete element;
-    return aux;
-}
-
-
-// ok atilio
-std::vector<Solution*> GeneticAlgorithm::initializePopulation(){
-
-    // Call randomized initialization to get a half of population
-    std::vector<Solution*> aux = this->prd->randomizedInitialization(this->populationSize - 1);
-
-    // Call greedy initialization to get +1 solution, probabily the best solution in this population
-    aux.push_back(this->prd->greedyInitialization());
-    
-    // Rest of population will be generated for randomizedSolution function
-    // for(int i = aux.size(); i < this->populationSize; i++){
-    //    aux.push_back(this->prd->randomSolution());
-    // }
-    return aux;
-}
-
-void GeneticAlgorithm::printVectorGA(std::vector<int> x, std::vector<int> y){
-    std::cout << "Dad -> { " ;
-    for(int i = 0; i < x.size(); i++){
-        std::cout << x[i];
-
-        if(i == x.size() - 1){
-            std::cout << " } - ";
-        }else{
-            std::cout << ", ";
-        }
-    }
-
-    std::cout << " Mom -> { " ;
-    for(int i = 0; i < y.size(); i++){
-        std::cout << y[i];
-
-        if(i == y.size() - 1){
-            std::cout << " }";
-        }else{
-            std::cout << ", ";
-        }
-    }
-
-    std::cout << std::endl;
-}
-
-void GeneticAlgorithm::printSolutions(std::vector<Solution*>& pop) {
-    for(Solution * ptr : pop) {
-        std::cout << "Fitness: " << ptr->fitness << std::endl;
-        std::cout << "Solution: ";
-        for(int i = 0; i < ptr->solution.size(); i++){
-            std::cout << ptr->solution[i] << " ";
-
-            if(i == ptr->solution.size() - 1){
-                std::cout << std::endl << std::endl;
-            }
-        }
-    }
-}
-
-void GeneticAlgorithm::printSingleSolution(Solution* ptr){
-    std::cout << "Fitness: " << ptr->fitness << std::endl;
-    std::cout << "Solution: ";
-    for(int i = 0; i < ptr->solution.size(); i++){
-        std::cout << ptr->solution[i] << " ";
-
-        if(i == ptr->solution.size() - 1){
-            std::cout << std::endl << std::endl;
-        }
-    }
-
-}
-
+#include "GA.hpp"
+#include "Solution.hpp"
+#include "../Common/Profile.hpp"
+#include "../Common/Seed.hpp"
+#include "SteadyPopulation.hpp"
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+// ok atilio!
+GeneticAlgorithm::GeneticAlgorithm(Graph* g, int popFactor, int tournSize, 
+    int stagnant,float mutRate, float eliSize, int maxGenerations, unsigned long seed,
+    float graspRate, double graspAlpha, int threads) : gen(SeedSequence(seed).child(0).seed()),dis(0.1, 1.0), disInt(0, 1) {
+
+    this->mutationRate = mutRate;
+    // Tournament selection draws tournSize + 1 distinct individuals
+    this->populationSize = std::max(g->numNodes / popFactor, tournSize + 1);
+    this->elitismSize = static_cast<std::size_t>(std::floor(this->populationSize * eliSize));
+    this->maxGenerations = maxGenerations;
+    this->maxStagnant = stagnant;
+    this->tournamentSize = tournSize;
+    this->graspRate = graspRate;
+    this->graspAlpha = graspAlpha;
+    this->threads = threads;
+
+    this->g = g;
+    // The operators and the random solutions draw from separate streams
+    this->prd = new PRD(this->g, SeedSequence(seed).child(1).seed());
+    this->population = this->initializePopulation();
+}
+
+// ok atilio
+GeneticAlgorithm::~GeneticAlgorithm(){
+    delete this->prd;
+    for(Solution* s: population){
+        delete s;
+    }
+    population.clear();
+}
+
+Result GeneticAlgorithm::gaFlow() {
+    if(this->steadyState){
+        return this->steadyStateFlow();
+    }
+
+    std::vector<Solution*> currentPop = this->population;  
+
+    Result res = Result(
+        this->g->graphName,
+        this->g->numNodes, 
+        this->g->numEdges,
+        static_cast<float>(2 * this->g->numEdges) / (this->g->numNodes * (this->g->numNodes - 1)),
+        std::numeric_limits<int>::max(),
+        0.0
+    );
+
+    const double TIME_LIMIT = 900.0;
+
+    auto begin = std::chrono::high_resolution_clock::now();
+    if(this->trace != nullptr){
+        this->trace->restart();
+    }
+
+    int gen = 0;
+    for(int i = 0; i < this->maxGenerations && gen < this->maxStagnant; i++){
+        PROFILE_SCOPE("ga.generation");
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::high_resolution_clock::now() - begin
+        ).count();
+
+        if (elapsed > TIME_LIMIT) {
+            res.elapsed_time = TIME_LIMIT;
+            this->population = currentPop;
+            return res;
+        }
+        // Selection
+        std::vector<std::pair<Solution*, Solution*>> select = GeneticAlgorithm::tournamentSelection(currentPop);
+
+        // Crossover
+        std::vector<Solution*> newPop  = GeneticAlgorithm::onePointCrossover(select);
+
+        // Mutation
+        GeneticAlgorithm::randomMutation(newPop);
+
+        // Elitism
+        currentPop = GeneticAlgorithm::defaultElitism(currentPop, newPop);
+
+        if(currentPop[0]->fitness < res.fitness) {
+            res.fitness = currentPop[0]->fitness;
+            gen = 0;
+            if(this->trace != nullptr){
+                this->trace->record(i + 1, res.fitness, diversity(currentPop));
+            }
+        }else {
+            gen++;
+        }
+
+        if(this->target >= 0 && res.fitness <= this->target) {
+            res.time_to_target = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count();
+            break;
+        }
+
+        // Nothing below the lower bound exists
+        if(res.fitness <= this->lowerBound) {
+            break;
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    res.elapsed_time = std::chrono::duration<double>(end - begin).count();
+
+    this->population = currentPop;
+    
+    return res;
+}
+
+// Every worker repeats: two tournaments for the parents, a one-point crossover
+// and the mutation into one child, and a single repair with an engine of its
+// own; the child then replaces the worst of a reverse tournament if it is no
+// worse. Nothing waits for the slowest repair of a generation, so the workers
+// never idle. The best individual is only replaced by one as good, which
+// makes the mode elitist without elitismSize. A generation counts as
+// populationSize children, for maxGenerations, maxStagnant and the trace.
+// With one thread the run is reproducible from the seed.
+Result GeneticAlgorithm::steadyStateFlow() {
+    Result res = Result(
+        this->g->graphName,
+        this->g->numNodes,
+        this->g->numEdges,
+        static_cast<float>(2 * this->g->numEdges) / (this->g->numNodes * (this->g->numNodes - 1)),
+        std::numeric_limits<int>::max(),
+        0.0
+    );
+
+    const double TIME_LIMIT = 900.0;
+    const int workers = std::max(this->threads, 1);
+    const long long perGeneration = this->populationSize;
+    const long long budget = static_cast<long long>(this->maxGenerations) * perGeneration;
+    const long long patience = static_cast<long long>(this->maxStagnant) * perGeneration;
+
+    SteadyPopulation population(this->population);
+    this->population.clear();
+    std::vector<unsigned long> seeds(workers);
+    for(unsigned long& seed : seeds){
+        seed = this->gen();
+    }
+
+    auto begin = std::chrono::high_resolution_clock::now();
+    if(this->trace != nullptr){
+        this->trace->restart();
+    }
+
+    std::atomic<long long> produced{0};
+    std::atomic<long long> lastImprovement{0};
+    std::atomic<long long> repairs{0};
+    std::atomic<bool> stop{false};
+    std::atomic<bool> timedOut{false};
+    std::atomic<int> best{std::numeric_limits<int>::max()};
+    std::mutex bestMutex;       // res, the trace and the target
+
+    // A child in the population with fitness below the incumbent, found as
+    // child number 'count'
+    auto improve = [&](Solution* child, long long count) {
+        std::lock_guard<std::mutex> lock(bestMutex);
+        if(child->fitness >= res.fitness){
+            return;
+        }
+        res.fitness = child->fitness;
+        best.store(child->fitness, std::memory_order_relaxed);
+        lastImprovement.store(count, std::memory_order_relaxed);
+        if(this->trace != nullptr){
+            // The child is already in the population
+            std::vector<std::shared_ptr<Solution>> individuals = population.snapshot();
+            std::vector<Solution*> pop;
+            for(const std::shared_ptr<Solution>& individual : individuals){
+                pop.push_back(individual.get());
+            }
+            this->trace->record(count / perGeneration + 1, res.fitness, diversity(pop));
+        }
+        if(this->target >= 0 && res.fitness <= this->target){
+            res.time_to_target = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count();
+            stop = true;
+        }
+        // Nothing below the lower bound exists
+        if(res.fitness <= this->lowerBound){
+            stop = true;
+        }
+    };
+
+    // The best individual of the initial population is the first incumbent
+    std::vector<std::shared_ptr<Solution>> initial = population.snapshot();
+    improve(std::min_element(initial.begin(), initial.end(),
+        [](const std::shared_ptr<Solution>& a, const std::shared_ptr<Solution>& b) { return *a < *b; })->get(), 0);
+    initial.clear();
+    if(budget <= 0){
+        stop = true;
+    }
+
+    auto work = [&](int worker) {
+        std::mt19937 random(seeds[worker]);
+        std::uniform_int_distribution<int> anySlot(0, population.size() - 1);
+        std::uniform_int_distribution<int> cutPoint(0, this->g->numNodes);
+        std::uniform_real_distribution<> chance(0.0, 1.0);
+        std::uniform_int_distribution<> disInt = this->disInt;
+        RepairEngine engine = this->prd->newEngine();
+        long long repaired = 0;
+
+        // The best of tournamentSize random slots, or with 'worst' the worst
+        auto tournament = [&](bool worst) {
+            int chosen = anySlot(random);
+            for(int k = 1; k < this->tournamentSize; k++){
+                const int i = anySlot(random);
+                const bool better = population.fitness(i) < population.fitness(chosen);
+                const bool worse = population.fitness(i) > population.fitness(chosen);
+                if(worst ? worse : better){
+                    chosen = i;
+                }
+            }
+            return chosen;
+        };
+
+        while(!stop.load(std::memory_order_relaxed)){
+            PROFILE_SCOPE("ga.steady_state_child");
+            std::shared_ptr<Solution> dad = population.get(tournament(false));
+            std::shared_ptr<Solution> mom = population.get(tournament(false));
+
+            const int cut = cutPoint(random);
+            Labelling labels(dad->solution.begin(), dad->solution.begin() + cut);
+            labels.insert(labels.end(), mom->solution.begin() + cut, mom->solution.end());
+            for(Label& label : labels){
+                if(chance(random) < this->mutationRate){
+                    label = disInt(random) * 2;
+                }
+            }
+            PROFILE_COUNT("rng.draws", labels.size() + 4 * this->tournamentSize + 1);
+            dad.reset();
+            mom.reset();
+
+            std::shared_ptr<Solution> child = std::make_shared<Solution>(std::move(labels), engine);
+            repaired++;
+            const bool inserted = population.replace(tournament(true), child);
+
+            // A child refused by its slot lost to an individual at least as
+            // good, which the worker that inserted it offers to improve
+            const long long count = ++produced;
+            if(inserted && child->fitness < best.load(std::memory_order_relaxed)){
+                improve(child.get(), count);
+            }
+            if(count >= budget || count - lastImprovement.load(std::memory_order_relaxed) >= patience){
+                stop = true;
+            }
+            const double elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count();
+            if(elapsed > TIME_LIMIT){
+                timedOut = true;
+                stop = true;
+            }
+        }
+        repairs += repaired;
+    };
+
+    std::vector<std::thread> threads;
+    for(int worker = 1; worker < workers; worker++){
+        threads.emplace_back(work, worker);
+    }
+    work(0);
+    for(std::thread& thread : threads){
+        thread.join();
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    res.elapsed_time = timedOut ? TIME_LIMIT : std::chrono::duration<double>(end - begin).count();
+    this->prd->repairs += repairs;
+    this->population = population.release();
+
+    return res;
+}
+
+// OPERATORS
+
+// ok atilio
+// Selection
+std::vector<std::pair<Solution*, Solution*>> GeneticAlgorithm::tournamentSelection(std::vector<Solution*> population) {
+    PROFILE_SCOPE("ga.selection");
+    std::vector<std::pair<Solution*, Solution*>> selectedPairs;
+    for(int i = 0; i < std::ceil(population.size()) / 2; i++){
+        std::vector<Solution*> auxiliary = population;
+        
+        // Embaralha o vetor
+        std::shuffle(auxiliary.begin(), auxiliary.end(), gen);
+        PROFILE_COUNT("rng.draws", auxiliary.size());
+    
+        Solution* first = GeneticAlgorithm::findMinimal(auxiliary);
+        
+        Solution* second = GeneticAlgorithm::findMinimal(auxiliary);
+        
+    
+        selectedPairs.push_back(std::make_pair(first, second));
+    }
+    return selectedPairs;
+}
+
+// Crossover
+std::vector<Solution*> GeneticAlgorithm::onePointCrossover(std::vector<std::pair<Solution*, Solution*>> pop) {
+    PROFILE_SCOPE("ga.crossover");
+    std::vector<Solution*> result;
+
+    for(size_t i = 0; i < pop.size(); i++){
+
+        std::pair<Solution*, Solution*> pair = pop[i];
+
+        Solution* dad = pair.first;
+        Solution* mom = pair.second;
+        
+        int solutionLength = this->g->numNodes;
+        int randomIndex = dis(gen);
+        PROFILE_COUNT("rng.draws", 1);
+        
+        // Two block copies of bytes each
+        Labelling firstChild(dad->solution.begin(), dad->solution.begin() + randomIndex);
+        Labelling secondChild(mom->solution.begin(), mom->solution.begin() + randomIndex);
+        firstChild.insert(firstChild.end(), mom->solution.begin() + randomIndex, mom->solution.begin() + solutionLength);
+        secondChild.insert(secondChild.end(), dad->solution.begin() + randomIndex, dad->solution.begin() + solutionLength);
+
+        if(this->populationSize % 2 == 1 && i+1 == pop.size()){
+            Solution* f = new Solution(firstChild, this->prd);
+            Solution* s = new Solution(secondChild, this->prd);
+
+            if(f->fitness < s->fitness){
+                result.push_back(f);
+                delete s;
+            }else{
+                result.push_back(s);
+                delete f;
+            }
+        }else{
+            result.push_back(new Solution(firstChild, this->prd));
+            result.push_back(new Solution(secondChild, this->prd));
+        }
+    }
+    return result;
+}
+
+
+// ok atilio
+// Mutation
+void GeneticAlgorithm::randomMutation(std::vector<Solution*>& pop){
+    PROFILE_SCOPE("ga.mutation");
+    for (Solution*& sol : pop) {
+        bool changed = false;
+        PROFILE_COUNT("rng.draws", sol->solution.size());
+        // For every gen, look if have mutation
+        for (size_t k = 0; k < sol->solution.size(); k++) {
+            if (dis(gen) < this->mutationRate) {
+                sol->solution[k] = disInt(gen) * 2;
+                changed = true;
+                PROFILE_COUNT("rng.draws", 1);
+            }
+        }
+        // Solution changed, recalculation required.
+        if (changed) {
+            sol = this->changeSolution(sol);
+        }
+    }
+}
+
+//Elitism
+std::vector<Solution*> GeneticAlgorithm::defaultElitism(std::vector<Solution*>& current, std::vector<Solution*>& newPop) {
+    PROFILE_SCOPE("ga.elitism");
+
+    std::vector<Solution*> result;
+    
+    // Sort the solution vectors
+    std::sort(current.begin(), current.end(), [](Solution* a, Solution* b) { return *a < *b;}); 
+    std::sort(newPop.begin(), newPop.end(), [](Solution* a, Solution* b) { return *a < *b;});
+
+    for(int i = 0; i < static_cast<int>(current.size()); i++){ 
+            if(i < this->elitismSize){
+                result.push_back(current[i]); 
+            }else{
+                delete current[i];
+            }
+        }
+    
+    // Copy the best features from this generagtion and free up the rest of memory.
+    int res = newPop.size() - this->elitismSize;
+    
+    for(int i = 0; i < static_cast<int>(newPop.size()); i++){ 
+        if(i < res){
+            result.push_back(newPop[i]);
+        }else {
+            delete newPop[i];
+        }  
+    } 
+    // Sort the result to get best solution on first position
+    std::sort(result.begin(), result.end(), [](Solution* a, Solution* b) { return *a < *b;}); 
+    return result;
+}
+
+// Auxiliary functions
+
+// ok atilio
+Solution* GeneticAlgorithm::findMinimal(std::vector<Solution*>& preSelected) {
+    Solution* minimal = preSelected[0];
+    int indexToRemove = 0;
+    for(int i = 1; i < this->tournamentSize; i++){
+        if(*preSelected[i] < *minimal){
+            minimal = preSelected[i];
+            indexToRemove = i;
+        }
+    }
+    preSelected.erase(preSelected.begin() + indexToRemove);
+    return minimal;
+}
+
+// ok atilio
+Solution* GeneticAlgorithm::changeSolution(Solution* element){
+    Solution* aux = new Solution(element->solution, this->prd);
+    delete element;
+    return aux;
+}
+
+
+// ok atilio
+std::vector<Solution*> GeneticAlgorithm::initializePopulation(){
+
+    // GRASP builds a share of the population: good starting points that
+    // still differ from each other
+    const int graspCount = std::min(this->populationSize - 1,
+        static_cast<int>(std::round(this->graspRate * this->populationSize)));
+
+    // Call randomized initialization to get the rest of the population
+    std::vector<Solution*> aux = this->prd->randomizedInitialization(this->populationSize - 1 - graspCount);
+
+    std::vector<Solution*> grasp = this->prd->graspInitialization(graspCount, this->graspAlpha, this->threads);
+    aux.insert(aux.end(), grasp.begin(), grasp.end());
+
+    // Call greedy initialization to get +1 solution, probabily the best solution in this population
+    aux.push_back(this->prd->greedyInitialization());
+    
+    // Rest of population will be generated for randomizedSolution function
+    // for(int i = aux.size(); i < this->populationSize; i++){
+    //    aux.push_back(this->prd->randomSolution());
+    // }
+    return aux;
+}
+
+void GeneticAlgorithm::printVectorGA(std::vector<int> x, std::vector<int> y){
+    std::cout << "Dad -> { " ;
+    for(size_t i = 0; i < x.size(); i++){
+        std::cout << x[i];
+
+        if(i == x.size() - 1){
+            std::cout << " } - ";
+        }else{
+            std::cout << ", ";
+        }
+    }
+
+    std::cout << " Mom -> { " ;
+    for(size_t i = 0; i < y.size(); i++){
+        std::cout << y[i];
+
+        if(i == y.size() - 1){
+            std::cout << " }";
+        }else{
+            std::cout << ", ";
+        }
+    }
+
+    std::cout << std::endl;
+}
+
+void GeneticAlgorithm::printSolutions(std::vector<Solution*>& pop) {
+    for(Solution * ptr : pop) {
+        std::cout << "Fitness: " << ptr->fitness << std::endl;
+        std::cout << "Solution: ";
+        for(size_t i = 0; i < ptr->solution.size(); i++){
+            std::cout << +ptr->solution[i] << " ";
+
+            if(i == ptr->solution.size() - 1){
+                std::cout << std::endl << std::endl;
+            }
+        }
+    }
+}
+
+void GeneticAlgorithm::printSingleSolution(Solution* ptr){
+    std::cout << "Fitness: " << ptr->fitness << std::endl;
+    std::cout << "Solution: ";
+    for(size_t i = 0; i < ptr->solution.size(); i++){
+        std::cout << +ptr->solution[i] << " ";
+
+        if(i == ptr->solution.size() - 1){
+            std::cout << std::endl << std::endl;
+        }
+    }
+
+}
+
+// Mean fraction of the labels of an individual that differ from the best one
+double GeneticAlgorithm::diversity(const std::vector<Solution*>& pop) const {
+    if(pop.size() < 2 || pop[0]->solution.empty()){
+        return 0.0;
+    }
+    const Labelling& best = pop[0]->solution;
+    long long differences = 0;
+    for(size_t i = 1; i < pop.size(); i++){
+        for(size_t v = 0; v < best.size(); v++){
+            differences += pop[i]->solution[v] != best[v];
+        }
+    }
+    return static_cast<double>(differences) / ((pop.size() - 1) * best.size());
+}
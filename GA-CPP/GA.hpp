@@ -1,60 +1,74 @@
-#ifndef GA_HPP
-#define GA_HPP
-#include "Graph.hpp"
-#include "Solution.hpp"
-#include "PRD.hpp"
-#include "Result.hpp"
-#include <chrono>
-
-class GeneticAlgorithm {
-        public:
-            float mutationRate;
-            float elitismSize;
-            int populationSize;
-            int maxGenerations;
-            int maxStagnant;
-            int tournamentSize;
-
-            std::mt19937 gen;
-            std::uniform_real_distribution<> dis; // [0, 1]
-            std::uniform_int_distribution<> disInt;   // {0, 1}
-
-            std::vector<Solution*> population;
-            Graph* g = nullptr;
-            PRD* prd = nullptr;
-
-            GeneticAlgorithm(Graph* g, int popFactor, int tournSize, int stagnant, float mutRate, float eliSize, int maxGenerations);
-
-            ~GeneticAlgorithm();
-
-            Result gaFlow();
-
-
-            // OPERATORS
-
-            // Selection
-            std::vector<std::pair<Solution*, Solution*>> tournamentSelection(std::vector<Solution*> population);
-
-            // Crossover
-            std::vector<Solution*> onePointCrossover(std::vector<std::pair<Solution*, Solution*>> pop);
-            
-            // Mutation
-            void randomMutation(std::vector<Solution*>& pop);
-
-            // Elitism
-            std::vector<Solution*> defaultElitism(std::vector<Solution*>& current, std::vector<Solution*>& newPop);
-
-        private:
-
-            // Auxiliary functions
-            Solution* findMinimal(std::vector<Solution*>& preSelected);
-            Solution* changeSolution(Solution* element);
-            std::vector<Solution*> initializePopulation();
-            void printVectorGA(std::vector<int> x, std::vector<int> y);
-            void printSolutions(std::vector<Solution*>& pop);
-            void printSingleSolution(Solution* solution);
-
-};
-
-
-#endif
+#ifndef GA_HPP
+#define GA_HPP
+#include "Graph.hpp"
+#include "Solution.hpp"
+#include "PRD.hpp"
+#include "Result.hpp"
+#include "../Common/Trace.hpp"
+#include <chrono>
+
+class GeneticAlgorithm {
+        public:
+            float mutationRate;
+            float elitismSize;
+            int populationSize;
+            int maxGenerations;
+            int maxStagnant;
+            int tournamentSize;
+            float graspRate;        // share of the initial population built by GRASP
+            double graspAlpha;      // RCL parameter of those constructions
+            int threads;            // threads of the GRASP constructions and of the steady state
+            int lowerBound = 0;     // the run stops once the best fitness reaches it
+            int target = -1;        // likewise, and the time is recorded; -1 for none
+            TraceSink* trace = nullptr;     // receives every improvement when set
+            bool steadyState = false;       // gaFlow runs steadyStateFlow
+
+            std::mt19937 gen;
+            std::uniform_real_distribution<> dis; // [0, 1]
+            std::uniform_int_distribution<> disInt;   // {0, 1}
+
+            std::vector<Solution*> population;
+            Graph* g = nullptr;
+            PRD* prd = nullptr;
+
+            GeneticAlgorithm(Graph* g, int popFactor, int tournSize, int stagnant, float mutRate, float eliSize, int maxGenerations,
+                unsigned long seed, float graspRate = 0.1, double graspAlpha = 0.3, int threads = 1);
+
+            ~GeneticAlgorithm();
+
+            Result gaFlow();
+
+            // Steady state: 'threads' workers each select two parents, then
+            // cross, mutate and repair one child, which replaces a worse
+            // individual, with no generation barrier
+            Result steadyStateFlow();
+
+            // OPERATORS
+
+            // Selection
+            std::vector<std::pair<Solution*, Solution*>> tournamentSelection(std::vector<Solution*> population);
+
+            // Crossover
+            std::vector<Solution*> onePointCrossover(std::vector<std::pair<Solution*, Solution*>> pop);
+            
+            // Mutation
+            void randomMutation(std::vector<Solution*>& pop);
+
+            // Elitism
+            std::vector<Solution*> defaultElitism(std::vector<Solution*>& current, std::vector<Solution*>& newPop);
+
+        private:
+
+            // Auxiliary functions
+            Solution* findMinimal(std::vector<Solution*>& preSelected);
+            Solution* changeSolution(Solution* element);
+            std::vector<Solution*> initializePopulation();
+            void printVectorGA(std::vector<int> x, std::vector<int> y);
+            void printSolutions(std::vector<Solution*>& pop);
+            void printSingleSolution(Solution* solution);
+            double diversity(const std::vector<Solution*>& pop) const;
+
+};
+
+
+#endif
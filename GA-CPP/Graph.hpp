@@ -1,22 +1,25 @@
-#ifndef GRAPH_CPP
-#define GRAPH_CPP
-#include "Node.hpp"
-#include <vector>
-#include <utility>
-#include <string>
-
-class Graph{
-    public:
-        int numNodes;
-        int numEdges;
-        std::string graphName;
-        std::vector<Node*> nodes;
-
-        Graph(int numNodes, int numEdges, std::vector<std::pair<int, int>>& edges, const std::string& gName);
-        ~Graph();
-        
-        std::vector<int> getLabels();
-        void printGraph();
-};
-
+#ifndef GRAPH_CPP
+#define GRAPH_CPP
+#include "Node.hpp"
+#include <vector>
+#include <utility>
+#include <string>
+
+class Graph{
+    public:
+        int numNodes;
+        int numEdges;
+        std::string graphName;
+        std::vector<Node*> nodes;
+
+        Graph(int numNodes, int numEdges, std::vector<std::pair<int, int>>& edges, const std::string& gName);
+        ~Graph();
+        
+        std::vector<int> getLabels();
+        void printGraph();
+};
+
+// Reads a graph file: "n m" followed by one "u v" line per edge
+void readEdgeList(const std::string& path, int& numNodes, int& numEdges, std::vector<std::pair<int, int>>& edges);
+
 #endif
\ No newline at end of file
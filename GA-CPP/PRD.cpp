@@ -1,263 +1,149 @@
-#include <cmath>
-#include "PRD.hpp"
-#include "Solution.hpp"
-
-// ok - atilio
-PRD::PRD(Graph* g) {
-    this->graph = g;
-}
-
-// ok - atilio
-bool PRD::checkPRD(Solution* sol) {
-    PRD::resetGraph(sol->solution); // Reset the graph
-    // Check if every vertex with label 0 has
-    // exacly one neighbor with label 2
-    for(Node* u: this->graph->nodes){
-        if((u->label == 0 && u->isDominated == false && u->dominatedFor == 0) || (u->label == 0 && u->isDominated == true && u->dominatedFor > 1)){
-            return false;
-        }
-    }
-    return true;
-}
-
-// ok atilio: corrigi uma parte do código abaixo
-Solution* PRD::greedyInitialization() {
-    this->restartGraph(); // Restart the graph
-
-    // Vertex with bigger degree has priority
-    auto cmp = [](Node* a, Node* b) {
-        return a->neighborhood.size() < b->neighborhood.size();
-    };
-
-    // Priority queue (max on front)
-    std::priority_queue<Node*, std::vector<Node*>, decltype(cmp)> pq(cmp);
-
-    // Push every vertex on queue
-    for (Node* node : this->graph->nodes){
-        pq.push(node);
-    }
-
-    while (!pq.empty()) {
-        Node* v = pq.top();
-        pq.pop();
-
-        if (v->label != -1){
-             continue;
-        }
-        // Isoled vertex case
-        if (v->neighborhood.empty()) {
-            v->label = 1;
-            v->isDominated = true;
-            v->dominatedFor++;
-            continue;
-        }
-
-        bool canBe2 = true;
-        // Analysis the neighbors
-        for (Node* neighbor : v->neighborhood) {
-            if ((neighbor->label == 0 && neighbor->isDominated) ||
-                neighbor->label == 1 || neighbor->label == 2){
-                    canBe2 = false;
-                }
-        }
-        // If can be 2, mark and domine the neighbors
-        if (canBe2 && !v->isDominated) {
-            v->label = 2;
-            v->isDominated = true;
-            v->dominatedFor++;
-            // Mark his neighbors unlabeled as 0
-            // and fix his attributes
-            for (Node* neighbor : v->neighborhood) {
-                if (neighbor->label == -1) {
-                    neighbor->label = 0;
-                    //neighbor->isDominated = true;
-                    //neighbor->dominatedFor++;
-                }
-                //Erick, acho que independente do vizinho, ele deve ser atualizado:
-                neighbor->isDominated = true;
-                neighbor->dominatedFor++; 
-            }
-        }
-        // Else, mark as 1
-        else if (!v->isDominated) {
-            v->label = 1;
-            v->isDominated = true;
-            v->dominatedFor++;
-        }
-        // If already dominated, defines as 0 if don't have label yet
-        else {
-            if (v->label == -1) v->label = 0;
-        }
-    }
-    // Create and return the new solution
-    return new Solution(this->graph->getLabels(), this);
-}
-
-
-// ok - atilio
-std::vector<Solution*> PRD::randomizedInitialization(int populationSize) {
-    std::vector<Solution*> final;
-    final.reserve(populationSize); 
-    // Create only the half
-    for (int i = 0; i < populationSize; ++i) {
-        final.push_back(randomSolution());
-    }
-    return final;
-}
-
-// ok - atilio
-Solution* PRD::randomSolution(){
-    std::random_device rd;      // fonte de entropia
-    std::mt19937 gen(rd());     // motor Mersenne Twister
-    std::uniform_int_distribution<> dist(0, 2); // intervalo [0, 2]
-
-    std::vector<int> sol;
-
-    while(sol.size() < this->graph->numNodes){
-        sol.push_back(dist(gen));
-    }
-
-    return new Solution(sol, this);
-}
-
-// ok - atilio
-// Auxiliary functions
-void PRD::restartGraph() {
-    for(int i = 0; i < this->graph->numNodes; i++){
-        this->graph->nodes[i]->label = -1;
-        this->graph->nodes[i]->isDominated = false;
-        this->graph->nodes[i]->dominatedFor = 0;
-    }
-}
-
-// ok - atilio
-void PRD::resetGraph(std::vector<int>& s){
-    restartGraph(); // Set the graph as new
-    for(int i = 0; i < this->graph->numNodes; i++){
-        this->graph->nodes[i]->label = s[i]; // Label the vertex
-        if(s[i] == 1){
-            this->graph->nodes[i]->isDominated = true; // Dominates himself
-            this->graph->nodes[i]->dominatedFor++; // Added +1 in dominance number
-        }else if(s[i] == 2){
-            this->graph->nodes[i]->isDominated = true; // Dominates himself
-            this->graph->nodes[i]->dominatedFor++; // Added +1 in dominance number
-
-            // For labels == 2, it's necessary to mark his neighbors as dominated and increase that dominance number
-            for(Node* u : this->graph->nodes[i]->neighborhood){
-                u->isDominated = true;
-                u->dominatedFor++;
-            }
-        }
-    }
-}
-
-// ok atilio
-void PRD::fixSolution(Solution* s){
-    
-    this->resetGraph(s->solution); // Reset the graph
-
-    this->reduceWeight(s); // Call reduceWeight beforehand
-    
-    for(int i = 0; i < this->graph->nodes.size(); i++){
-        Node* u = this->graph->nodes[i];
-        if(u->label == 0) {
-            // If u is dominated from unic vertex with label = 2
-            // u can be keep having label = 0
-            if(u->dominatedFor == 1){
-                continue;
-            } 
-            if(u->dominatedFor >= 2) {
-                // In this case, u needs to have label = 1 
-                u->label = 1;
-                u->dominatedFor++;
-                u->isDominated = true;
-                s->solution[i] = 1;
-            }
-            else { // nesse caso label[u] == 0 e ele não tem nenhum vizinho com rótulo 2
-                // Check if u has some neighbor with label 0 that is dominated
-                bool hasSomeDominated = false;
-                for(Node* v: u->neighborhood){
-                    if(v->label == 0 && v->isDominated){
-                        hasSomeDominated = true;
-                        break;
-                    }
-                }
-                // If u its not dominated and his neighbors are not dominated too
-                // nesse momento sabemos com certeza que: u->dominatedFor == 0
-                if(!hasSomeDominated){
-                    u->label = 2;
-                    u->isDominated = true;
-                    u->dominatedFor++;
-
-                    s->solution[i] = 2;
-
-                    // Set his neighbors as dominated and increase his dominated number
-                    for(Node* v: u->neighborhood){
-                        v->isDominated = true;
-                        v->dominatedFor++;
-                    }
-                } else {
-                    // In this case, u needs to have label = 1 
-                    u->label = 1;
-                    u->dominatedFor++;
-                    u->isDominated = true;
-                    s->solution[i] = 1;
-                }
-            }
-        }
-    }
-    
-   this->reduceWeight(s); // Call reduceWeight again
-}
-
-// ok atilio
-void PRD::reduceWeight(Solution* s){
-
-    for(int i = 0; i < this->graph->numNodes; i++){
-        Node* u = this->graph->nodes[i];
-
-        if(u->label == 2){
-            // Check if nodes with label = 2 
-            // are dominating someone
-            bool safe = true;
-
-            for(Node* v: u->neighborhood){
-                if(v->label == 0 && v->dominatedFor == 1){
-                    safe = false;
-                    break;
-                }
-            }
-            // If is not dominating someone
-            // he can ben = 1
-            if(safe){
-                u->label = 1;
-
-                s->solution[i] = 1;
-
-                // Fix his neighbors
-                for(Node* w: u->neighborhood){
-                    w->dominatedFor--;
-                    if(w->label == 0 && w->dominatedFor == 0){
-                        w->isDominated = false;
-                    }
-                }
-            }
-        }
-    }
-
-    // For every vertex with label = 1, 
-    // if it is dominated by exactly one vertex 
-    // with label = 2, so he can have label = 0
-    for(int i = 0; i < this->graph->numNodes; i++){
-        Node* v = this->graph->nodes[i];
-
-        if(v->label == 1 && v->dominatedFor == 2){
-            v->label = 0;
-            v->dominatedFor--;
-
-            s->solution[i] = 0;
-        }
-    }
-    
-}
-
+#include <cmath>
+#include "PRD.hpp"
+#include "Solution.hpp"
+#include "../Common/Profile.hpp"
+#include "../Common/Seed.hpp"
+#include "../Common/Greedy.hpp"
+#include <unordered_map>
+
+// ok - atilio
+PRD::PRD(Graph* g, unsigned long seed) : seed(seed), rng(seed) {
+    this->graph = g;
+
+    std::unordered_map<Node*, int> index;
+    for (int i = 0; i < g->numNodes; i++) index[g->nodes[i]] = i;
+    this->adjacency.resize(g->numNodes);
+    for (int i = 0; i < g->numNodes; i++) {
+        for (Node* v : g->nodes[i]->neighborhood) this->adjacency[i].push_back(index[v]);
+    }
+    this->dense = denseAdjacency(this->adjacency);
+    this->engine.setDense(this->dense.get());
+    this->bounded = boundedAdjacency(this->adjacency);
+    this->engine.setBounded(&this->bounded);
+}
+
+// ok - atilio
+bool PRD::checkPRD(Solution* sol) {
+    if (this->dense) return this->dense->isPerfectRoman(sol->solution);
+
+    PRD::resetGraph(sol->solution); // Reset the graph
+    // Check if every vertex with label 0 has
+    // exacly one neighbor with label 2
+    for(Node* u: this->graph->nodes){
+        if((u->label == 0 && u->isDominated == false && u->dominatedFor == 0) || (u->label == 0 && u->isDominated == true && u->dominatedFor > 1)){
+            return false;
+        }
+    }
+    return true;
+}
+
+Solution* PRD::greedyInitialization() {
+    PROFILE_SCOPE("prd.greedy");
+    return new Solution(toLabelling(greedyPerfectRoman(this->adjacency)), this);
+}
+
+std::vector<Solution*> PRD::graspInitialization(int count, double alpha, int threads) {
+    PROFILE_SCOPE("prd.grasp");
+    std::vector<Labelling> labels(std::max(count, 0));
+
+    // The constructions only read the adjacency, so they can go in parallel
+    #ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 1) num_threads(std::max(threads, 1))
+    #endif
+    for (int k = 0; k < count; k++) {
+        std::mt19937 random(SeedSequence(this->seed).child(k).seed());
+        labels[k] = toLabelling(greedyPerfectRoman(this->adjacency, alpha, &random));
+    }
+
+    // The repair engine holds one labelling, so the repairs go one at a time
+    std::vector<Solution*> solutions;
+    solutions.reserve(labels.size());
+    for (Labelling& l : labels) {
+        solutions.push_back(new Solution(l, this));
+    }
+    return solutions;
+}
+
+// ok - atilio
+std::vector<Solution*> PRD::randomizedInitialization(int populationSize) {
+    std::vector<Solution*> final;
+    final.reserve(populationSize); 
+    // Create only the half
+    for (int i = 0; i < populationSize; ++i) {
+        final.push_back(randomSolution());
+    }
+    return final;
+}
+
+// ok - atilio
+Solution* PRD::randomSolution(){
+    std::uniform_int_distribution<> dist(0, 2); // intervalo [0, 2]
+
+    Labelling sol;
+
+    while(static_cast<int>(sol.size()) < this->graph->numNodes){
+        sol.push_back(dist(this->rng));
+    }
+
+    return new Solution(sol, this);
+}
+
+// ok - atilio
+// Auxiliary functions
+void PRD::restartGraph() {
+    for(int i = 0; i < this->graph->numNodes; i++){
+        this->graph->nodes[i]->label = -1;
+        this->graph->nodes[i]->isDominated = false;
+        this->graph->nodes[i]->dominatedFor = 0;
+    }
+}
+
+// ok - atilio
+void PRD::resetGraph(const Labelling& s){
+    restartGraph(); // Set the graph as new
+    for(int i = 0; i < this->graph->numNodes; i++){
+        this->graph->nodes[i]->label = s[i]; // Label the vertex
+        if(s[i] == 1){
+            this->graph->nodes[i]->isDominated = true; // Dominates himself
+            this->graph->nodes[i]->dominatedFor++; // Added +1 in dominance number
+        }else if(s[i] == 2){
+            this->graph->nodes[i]->isDominated = true; // Dominates himself
+            this->graph->nodes[i]->dominatedFor++; // Added +1 in dominance number
+
+            // For labels == 2, it's necessary to mark his neighbors as dominated and increase that dominance number
+            for(Node* u : this->graph->nodes[i]->neighborhood){
+                u->isDominated = true;
+                u->dominatedFor++;
+            }
+        }
+    }
+}
+
+// ok atilio
+void PRD::fixSolution(Solution* s){
+    PROFILE_SCOPE("prd.repair");
+    this->repairs++;
+
+    // The engine still holds the last repaired labelling, so when s is close
+    // to it only the vertices where they differ, and those around them, are
+    // examined: reduce, repair the 0s, reduce again
+    this->engine.assign(s->solution);
+    this->engine.fix();
+    s->solution = this->engine.labels();
+}
+
+RepairEngine PRD::newEngine() const {
+    RepairEngine engine(this->adjacency, this->dense.get());
+    engine.setBounded(&this->bounded);
+    return engine;
+}
+
+// ok atilio
+void PRD::reduceWeight(Solution* s){
+    PROFILE_SCOPE("prd.reduce_weight");
+
+    this->engine.assign(s->solution);
+    this->engine.reduce();
+    s->solution = this->engine.labels();
+}
+
@@ -1,38 +1,56 @@
-#ifndef PRD_HPP
-#define PRD_HPP
-#include "Graph.hpp"
-#include <algorithm>
-#include <queue>
-#include <functional>
-#include <iostream>
-#include <random>
-
-class Solution; // Circular dependency   
- 
-
-class PRD {
-    public:
-        Graph* graph;
-        PRD(Graph* g);
-        ~PRD() = default;
-
-        bool checkPRD(Solution* sol);
-        Solution* greedyInitialization();
-        Solution* randomSolution();
-        void fixSolution(Solution* s);
-        void reduceWeight(Solution* s); 
-        std::vector<Solution*> randomizedInitialization(int populationSize);
-        
-    private:
-        void resetGraph(std::vector<int>& s);
-        void restartGraph();
-};
-
-
-
-
-#endif
-
-
-
-
+#ifndef PRD_HPP
+#define PRD_HPP
+#include "Graph.hpp"
+#include "../Common/Repair.hpp"
+#include <algorithm>
+#include <memory>
+#include <queue>
+#include <functional>
+#include <iostream>
+#include <random>
+
+class Solution; // Circular dependency   
+ 
+
+class PRD {
+    public:
+        Graph* graph;
+        long long repairs = 0;      // calls of fixSolution, for throughput measurements
+
+        PRD(Graph* g, unsigned long seed);
+        ~PRD() = default;
+
+        bool checkPRD(Solution* sol);
+        Solution* greedyInitialization();
+        // 'count' GRASP constructions with RCL parameter alpha in [0, 1],
+        // built on up to 'threads' threads; construction k draws from stream
+        // k of the PRD seed
+        std::vector<Solution*> graspInitialization(int count, double alpha, int threads = 1);
+        Solution* randomSolution();
+        void fixSolution(Solution* s);
+        // A repair engine of its own, set up as the one of fixSolution, for a
+        // thread that repairs alongside others
+        RepairEngine newEngine() const;
+        void reduceWeight(Solution* s); 
+        std::vector<Solution*> randomizedInitialization(int populationSize);
+        
+    private:
+        unsigned long seed;
+        std::mt19937 rng;           // draws the random solutions
+        std::vector<std::vector<int>> adjacency;    // neighbours by index, for the constructions and the repair
+        std::unique_ptr<DenseAdjacency> dense;      // bitset form of adjacency on dense graphs, else nullptr
+        BoundedAdjacency bounded;                   // fixed-degree form of adjacency when its degrees are small
+        RepairEngine engine{adjacency};             // holds the last repaired labelling
+
+        void resetGraph(const Labelling& s);
+        void restartGraph();
+};
+
+
+
+
+#endif
+
+
+
+
@@ -1,61 +1,68 @@
-#include "Solution.hpp"
-#include "PRD.hpp"
-
-
-// ok - atilio
-Solution::Solution(std::vector<int> solution, PRD* prd){
-    this->solution = solution;
-    
-    /*this->isValid = prd->checkPRD(this);
-    while(!isValid){
-        prd->fixSolution(this); // Fix his solution
-        bool test = prd->checkPRD(this);
-        this->isValid = test;
-    }*/
-    
-    prd->fixSolution(this);
-    //this->isValid = true;
-    this->fitness = this->calculateFitness();
-}
-
-// ok - atilio
-int Solution::calculateFitness(){
-    int fitness = 0;
-    for(int i = 0; i < this->solution.size(); i++){
-        fitness += this->solution[i];
-    }
-    //if(!this->isValid) fitness += this->solution.size() * 5; // Penality
-
-    return fitness;
-}
-
-// ok - atilio
-bool Solution::operator >(const Solution& other) const{
-    return this->fitness > other.fitness;
-}
-// ok - atilio
-bool Solution::operator <(const Solution& other) const{
-    return this->fitness < other.fitness;
-}
-// ok - atilio
-bool Solution::operator ==(const Solution& other) const{
-    return this->fitness == other.fitness;
-}
-// ok - atilio
-bool Solution::operator >=(const Solution& other) const{
-    return this->fitness >= other.fitness;
-}
-// ok - atilio
-bool Solution::operator <=(const Solution& other) const{
-    return this->fitness <= other.fitness;
-}
-
-// ok - atilio
-void Solution::printSolution(){
-    std::cout << "Solution: ";
-    for(int i = 0; i < this->solution.size(); i++){
-        std::cout << this->solution[i] << " ";
-    }
-    //std::cout << "\nFitness: " << this->fitness << " - isValid:" << this->isValid << std::endl;
-    std::cout << "\nFitness: " << this->fitness << std::endl;
-}
+#include "Solution.hpp"
+#include "PRD.hpp"
+#include "../Common/Profile.hpp"
+#include "../Common/Repair.hpp"
+
+
+// ok - atilio
+Solution::Solution(Labelling solution, PRD* prd){
+    PROFILE_COUNT("allocations.solutions", 1);
+    this->solution = std::move(solution);
+    
+    /*this->isValid = prd->checkPRD(this);
+    while(!isValid){
+        prd->fixSolution(this); // Fix his solution
+        bool test = prd->checkPRD(this);
+        this->isValid = test;
+    }*/
+    
+    prd->fixSolution(this);
+    //this->isValid = true;
+    this->fitness = this->calculateFitness();
+}
+
+Solution::Solution(Labelling solution, RepairEngine& engine){
+    PROFILE_COUNT("allocations.solutions", 1);
+    engine.assign(solution);
+    engine.fix();
+    this->solution = engine.labels();
+    this->fitness = this->calculateFitness();
+}
+
+// ok - atilio
+int Solution::calculateFitness(){
+    //if(!this->isValid) fitness += this->solution.size() * 5; // Penality
+
+    return labelWeight(this->solution);
+}
+
+// ok - atilio
+bool Solution::operator >(const Solution& other) const{
+    return this->fitness > other.fitness;
+}
+// ok - atilio
+bool Solution::operator <(const Solution& other) const{
+    return this->fitness < other.fitness;
+}
+// ok - atilio
+bool Solution::operator ==(const Solution& other) const{
+    return this->fitness == other.fitness;
+}
+// ok - atilio
+bool Solution::operator >=(const Solution& other) const{
+    return this->fitness >= other.fitness;
+}
+// ok - atilio
+bool Solution::operator <=(const Solution& other) const{
+    return this->fitness <= other.fitness;
+}
+
+// ok - atilio
+void Solution::printSolution(){
+    std::cout << "Solution: ";
+    for(size_t i = 0; i < this->solution.size(); i++){
+        std::cout << +this->solution[i] << " ";
+    }
+    //std::cout << "\nFitness: " << this->fitness << " - isValid:" << this->isValid << std::endl;
+    std::cout << "\nFitness: " << this->fitness << std::endl;
+}
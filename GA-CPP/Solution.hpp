@@ -1,27 +1,32 @@
-#ifndef SOLUTION_HPP
-#define SOLUTION_HPP
-#include <vector>
-
-class PRD; // Circular dependency
-
-class Solution {
-    public:
-        std::vector<int> solution;
-        //bool isValid;
-        int fitness;
-        
-        Solution(std::vector<int> solution, PRD* prd);
-        ~Solution() = default;
-        
-        int calculateFitness();
-        void printSolution();
-
-
-        bool operator >(const Solution& other) const;
-        bool operator <(const Solution& other) const;
-        bool operator ==(const Solution& other) const;
-        bool operator >=(const Solution& other) const;
-        bool operator <=(const Solution& other) const;
-};
-
+#ifndef SOLUTION_HPP
+#define SOLUTION_HPP
+#include "../Common/RomanGraph.hpp"
+#include <vector>
+
+class PRD; // Circular dependency
+class RepairEngine;
+
+class Solution {
+    public:
+        Labelling solution;
+        //bool isValid;
+        int fitness;
+        
+        Solution(Labelling solution, PRD* prd);
+        // Repaired by 'engine' instead of the engine of the PRD, for threads
+        // that repair alongside each other
+        Solution(Labelling solution, RepairEngine& engine);
+        ~Solution() = default;
+        
+        int calculateFitness();
+        void printSolution();
+
+
+        bool operator >(const Solution& other) const;
+        bool operator <(const Solution& other) const;
+        bool operator ==(const Solution& other) const;
+        bool operator >=(const Solution& other) const;
+        bool operator <=(const Solution& other) const;
+};
+
 #endif
\ No newline at end of file
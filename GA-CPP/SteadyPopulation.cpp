@@ -0,0 +1,46 @@
+#include "SteadyPopulation.hpp"
+#include <algorithm>
+
+SteadyPopulation::SteadyPopulation(const std::vector<Solution*>& individuals) : slots(individuals.size()) {
+    for (size_t i = 0; i < individuals.size(); i++) {
+        this->slots[i].solution.reset(individuals[i]);
+        this->slots[i].fitness.store(individuals[i]->fitness, std::memory_order_relaxed);
+    }
+}
+
+std::shared_ptr<Solution> SteadyPopulation::get(int i) const {
+    std::lock_guard<std::mutex> lock(this->slots[i].mutex);
+    return this->slots[i].solution;
+}
+
+bool SteadyPopulation::replace(int i, const std::shared_ptr<Solution>& child) {
+    Slot& slot = this->slots[i];
+    std::shared_ptr<Solution> old;
+    {
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        // Another worker may have replaced it since the tournament read it
+        if (child->fitness > slot.solution->fitness) return false;
+        old = std::move(slot.solution);
+        slot.solution = child;
+        slot.fitness.store(child->fitness, std::memory_order_relaxed);
+    }
+    // The replaced individual, unless a worker still reads it, is freed here,
+    // outside the lock
+    old.reset();
+    return true;
+}
+
+std::vector<std::shared_ptr<Solution>> SteadyPopulation::snapshot() const {
+    std::vector<std::shared_ptr<Solution>> individuals;
+    individuals.reserve(this->slots.size());
+    for (int i = 0; i < this->size(); i++) individuals.push_back(this->get(i));
+    return individuals;
+}
+
+std::vector<Solution*> SteadyPopulation::release() const {
+    std::vector<Solution*> individuals;
+    individuals.reserve(this->slots.size());
+    for (const std::shared_ptr<Solution>& individual : this->snapshot()) individuals.push_back(new Solution(*individual));
+    std::sort(individuals.begin(), individuals.end(), [](Solution* a, Solution* b) { return *a < *b; });
+    return individuals;
+}
@@ -0,0 +1,43 @@
+#ifndef STEADY_POPULATION_HPP
+#define STEADY_POPULATION_HPP
+#include "Solution.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Population of the steady-state GA, shared by its worker threads. It is
+// sharded down to single individuals: every slot has a lock of its own, so
+// two workers only wait for each other when they touch the same slot at the
+// same time, and nothing ever stops the whole population. An individual is
+// not changed once inserted, and workers hold their parents by shared_ptr,
+// so a parent stays valid while its slot is replaced. The fitness of every
+// slot is mirrored in an atomic, so tournaments compare slots without locks.
+class SteadyPopulation {
+    public:
+        // Takes ownership of 'individuals'
+        explicit SteadyPopulation(const std::vector<Solution*>& individuals);
+
+        int size() const { return this->slots.size(); }
+        int fitness(int i) const { return this->slots[i].fitness.load(std::memory_order_relaxed); }
+        std::shared_ptr<Solution> get(int i) const;
+
+        // Puts 'child' in slot i if it is no worse than the individual there
+        bool replace(int i, const std::shared_ptr<Solution>& child);
+
+        // The individuals at some moment, each slot read under its lock
+        std::vector<std::shared_ptr<Solution>> snapshot() const;
+
+        // Copies of the individuals, best first, owned by the caller
+        std::vector<Solution*> release() const;
+
+    private:
+        struct Slot {
+            mutable std::mutex mutex;
+            std::shared_ptr<Solution> solution;
+            std::atomic<int> fitness{0};
+        };
+        std::vector<Slot> slots;
+};
+
+#endif
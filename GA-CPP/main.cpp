@@ -1,241 +1,649 @@
-#include "GA.hpp"
-#include <fstream>
-#include <filesystem>
-
-#define IRACE 0
-
-namespace fs = std::filesystem;
-using namespace std;
-
-struct Parameters {
-
-    #if IRACE
-    long unsigned iraceSeed = 0;
-    #endif
-
-    int maxStagnant = 150;
-    int generations = 500;
-    int tournamentSize = 5;
-    int trials = 1;
-    float crossoverRate = 0.8;
-    float populationFactor = 3;
-    float elitismRate = 0.1;
-    float mutationRate = 0.1;
-    std::string file_path;
-    std::string output_file = "results.csv";
-};
-
-// struct Result {
-//     std::string graph_name;
-//     int node_count;
-//     int edge_count;
-//     float graph_density;
-//     int fitness;
-//     double elapsed_time;
-// };
-
-Parameters parse_args(int argc, char *argv[]);
-void printParameters(const Parameters& p);
-void ensure_csv_header(const std::string &filename);
-void write_result_to_csv(const std::string &filename, const Result &result);
-void runGA(Parameters params, const std::string& path);
-
-int main(int argc, char *argv[]){
-    Parameters params = parse_args(argc, argv);
-
-    #if !IRACE
-    ensure_csv_header(params.output_file);
-    #endif
-
-    runGA(params, params.file_path);
-    
-    return 0;
-}
-
-void runGA(Parameters params, const std::string& path) {
-
-    std::ifstream file(path);
-    if (!file.is_open()) {
-        throw std::runtime_error("Error opening file: " + path);
-    }
-
-    int num_vertex, num_edges;
-
-    file >> num_vertex >> num_edges;
-    
-    vector<pair<int, int>> edges;
-    edges.reserve(num_edges);
-    int u, v;
-    while (file >> u >> v) {
-        edges.push_back(make_pair(u,v));
-    }
-    
-    Graph* g = new Graph(num_vertex, num_edges, edges, fs::path (path).stem().string());
-    
-    file.close();
-    
-    for(int trial = 0; trial < params.trials; trial++){
-        
-        
-        GeneticAlgorithm* GA = new GeneticAlgorithm(g, params.populationFactor, params.tournamentSize, params.maxStagnant, params.mutationRate, params.elitismRate, params.generations);
-    
-        // auto begin = std::chrono::high_resolution_clock::now();
-    
-        Result res = GA->gaFlow();
-    
-        // auto end = std::chrono::high_resolution_clock::now();
-        // auto elapsed_time = std::chrono::duration<double>(end - begin);
-    
-        // res.node_count = num_vertex;
-        // res.edge_count = num_edges;
-        // res.elapsed_time = elapsed_time.count();
-        // res.graph_density = static_cast<float>(2 * num_edges) / (num_vertex * (num_vertex - 1));
-        // res.graph_name = GA->g->graphName;
-        // res.fitness = GA->bestFitness;
-
-        #if !IRACE
-        write_result_to_csv(params.output_file, res);
-        #endif
-
-        #if IRACE
-        cout << res.fitness << endl;
-        #endif
-
-        delete GA;
-    }
-
-    delete g;
-
-}
-
-void ensure_csv_header(const std::string &filename) {
-    bool file_exists = std::filesystem::exists(filename);
-    std::ofstream file;
-    if (!file_exists) {
-        file.open(filename);
-        file << "graph_name,graph_order,graph_size,density,fitness_value,elapsed_time(seconds)\n";
-        file.close();
-    } 
-}
-
-void write_result_to_csv(const std::string &filename, const Result &result) {
-    std::ofstream file(filename, std::ios::app);
-    file << result.graph_name << "," << result.node_count << ","
-         << result.edge_count << "," << result.graph_density << "," << result.fitness << ","
-         << result.elapsed_time << "\n"; 
-    file.close();
-}
-
-
-void printParameters(const Parameters& p) {
-    std::cout << "===== Genetic Algorithm Parameters =====\n";
-    std::cout << std::left;
-
-    std::cout << std::setw(20) << "Graph file:"       << p.file_path       << "\n";
-    std::cout << std::setw(20) << "Output file:"      << p.output_file     << "\n";
-    std::cout << std::setw(20) << "Generations:"      << p.generations     << "\n";
-    std::cout << std::setw(20) << "Max stagnant:"     << p.maxStagnant     << "\n";
-    std::cout << std::setw(20) << "Tournament size:"  << p.tournamentSize  << "\n";
-    std::cout << std::setw(20) << "Population factor:"<< p.populationFactor<< "\n";
-    std::cout << std::setw(20) << "Elitism rate:"     << p.elitismRate     << "\n";
-    std::cout << std::setw(20) << "Mutation rate:"    << p.mutationRate    << "\n";
-    std::cout << std::setw(20) << "Total trials:"    << p.trials    << "\n";
-    std::cout << "=========================================\n";
-}
-
-Parameters parse_args(int argc, char *argv[]) {
-    Parameters parameters;
-
-    if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <graph_file> [options]\n"
-                  << "Options:\n"
-                  << "  --crossover VALUE\n"
-                  << "  --stagnation VALUE\n"
-                  << "  --generations VALUE\n"
-                  << "  --populationFactor VALUE\n"
-                  << "  --tournament VALUE\n"
-                  << "  --elitism VALUE\n"
-                  << "  --mutation VALUE\n"
-                  << "  --trials VALUE\n"
-                  << "  --output FILE\n";
-        exit(1);
-      }
-
-    #if !IRACE
-    parameters.file_path = argv[1];
-
-    for (int i = 2; i < argc; i++) {
-        std::string arg = argv[i];
-        if (arg == "--stagnation" && i + 1 < argc) {
-            parameters.maxStagnant = std::stoi(argv[++i]);
-
-        } else if (arg == "--generations" && i + 1 < argc) {
-            parameters.generations = std::stoi(argv[++i]);
-
-        } else if (arg == "--populationFactor" && i + 1 < argc) {
-            parameters.populationFactor = std::stoi(argv[++i]);
-
-        } else if (arg == "--tournament" && i + 1 < argc) {
-            parameters.tournamentSize = std::stoi(argv[++i]);
-
-        } else if (arg == "--elitism" && i + 1 < argc) {
-            parameters.elitismRate = std::stof(argv[++i]);
-
-        } else if (arg == "--mutation" && i + 1 < argc) {
-            parameters.mutationRate = std::stof(argv[++i]);
-
-        } else if (arg == "--output" && i + 1 < argc) {
-            parameters.output_file = argv[++i];
-
-        } else if (arg == "--trials" && i + 1 < argc) {
-            parameters.trials = std::stoi(argv[++i]);
-
-        } else {
-            std::cerr << "Unknown argument: " << arg << std::endl;
-            exit(1);
-        }
-    }
-
-    #endif
-
-    #if IRACE
-
-    parameters.iraceSeed = std::stoul(argv[3]);         // seed for random number generator 
-    parameters.file_path = argv[4];                     // path for instance
-    
-    for (int i = 5; i < argc; i++) {
-        std::string arg = argv[i];
-        if (arg == "--stagnation" && i + 1 < argc) {
-            parameters.maxStagnant = std::stoi(argv[++i]);
-
-        } else if (arg == "--generations" && i + 1 < argc) {
-            parameters.generations = std::stoi(argv[++i]);
-
-        } else if (arg == "--populationFactor" && i + 1 < argc) {
-            parameters.populationFactor = std::stoi(argv[++i]);
-
-        } else if (arg == "--tournament" && i + 1 < argc) {
-            parameters.tournamentSize = std::stoi(argv[++i]);
-
-        } else if (arg == "--elitism" && i + 1 < argc) {
-            parameters.elitismRate = std::stof(argv[++i]);
-
-        } else if (arg == "--mutation" && i + 1 < argc) {
-            parameters.mutationRate = std::stof(argv[++i]);
-
-        } else if (arg == "--output" && i + 1 < argc) {
-            parameters.output_file = argv[++i];
-
-        } else if (arg == "--trials" && i + 1 < argc) {
-            parameters.trials = std::stoi(argv[++i]);
-
-        } else {
-            std::cerr << "Unknown argument: " << arg << std::endl;
-            exit(1);
-        }
-    }
-
-    #endif
-
-    return parameters;
+#include "GA.hpp"
+#include "../Common/Reduction.hpp"
+#include "../Common/Reorder.hpp"
+#include "../Common/Components.hpp"
+#include "../Common/LowerBound.hpp"
+#include "../Common/KnownOptima.hpp"
+#include "../Common/TTT.hpp"
+#include "../Common/Trace.hpp"
+#include "../Common/Profile.hpp"
+#include "../Common/Batch.hpp"
+#include "../Common/Server.hpp"
+#include "../Common/Seed.hpp"
+#include <fstream>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+
+#define IRACE 0
+
+namespace fs = std::filesystem;
+using namespace std;
+
+struct Parameters {
+
+    int maxStagnant = 150;
+    int generations = 500;
+    int tournamentSize = 5;
+    int trials = 1;
+    float crossoverRate = 0.8;
+    float populationFactor = 3;
+    float elitismRate = 0.1;
+    float mutationRate = 0.1;
+    float graspRate = 0.1;      // share of the initial population built by GRASP
+    float graspAlpha = 0.3;     // RCL parameter of GRASP, 0 for pure greedy
+    bool reduce = false;
+    bool components = false;
+    VertexOrder order = VertexOrder::NONE;  // relabelling of the searched graph for locality
+    int threads = 1;
+    bool steadyState = false;   // steady-state GA on the threads instead of generations
+    long unsigned seed = std::random_device{}();    // master seed of the run (--seed, or the seed of irace)
+    bool drawnSeed = true;      // no --seed: the seed above was drawn, and is printed
+    std::vector<int> targets;   // --target weights, several only for --ttt; empty for none
+    int ttt = 0;                // runs of a time-to-target experiment; 0 for a normal run
+    std::string known_optima;
+    std::string trace;          // convergence trace file; empty for none
+    std::string batch;          // directory or instance list of a batch run; empty for one graph
+    int workers = 0;            // threads of a batch run or server; 0 for one per hardware thread
+    std::string server;         // socket of the evaluation server, "-" for stdin; empty for none
+    std::string instances;      // directory or instance list the server preloads
+    std::string file_path;
+    std::string output_file = "results.csv";
+};
+
+// struct Result {
+//     std::string graph_name;
+//     int node_count;
+//     int edge_count;
+//     float graph_density;
+//     int fitness;
+//     double elapsed_time;
+// };
+
+Parameters parse_args(int argc, char *argv[]);
+bool parse_option(Parameters& parameters, int argc, char *argv[], int& i);
+void printParameters(const Parameters& p);
+void ensure_csv_header(const std::string &filename);
+std::string csv_row(const Result &result);
+void write_result_to_csv(const std::string &filename, const Result &result);
+void runGA(Parameters params, const std::string& path);
+void runBatchGA(const Parameters& params);
+void runServerGA(const Parameters& params);
+Solution* bestSolution(GeneticAlgorithm* GA);
+std::vector<int> solveWithGA(const Parameters& params, const Adjacency& adj, int bound, const std::string& name, unsigned long seed);
+
+int main(int argc, char *argv[]){
+    Parameters params = parse_args(argc, argv);
+
+    #if !IRACE
+    if(params.ttt == 0 && params.server.empty()) ensure_csv_header(params.output_file);
+
+    // A drawn seed is the only way to repeat the run
+    if(params.drawnSeed && params.server.empty()){
+        std::cout << "Seed: " << params.seed << std::endl;
+    }
+    #endif
+
+    if(!params.server.empty()){
+        runServerGA(params);
+    }else if(!params.batch.empty()){
+        runBatchGA(params);
+    }else{
+        runGA(params, params.file_path);
+    }
+    
+    return 0;
+}
+
+// Everything the trials on one graph share: the input, the exact reduction,
+// the vertex ordering, the bounds, the target and the component decomposition
+struct PreparedGraph {
+    std::string graphName;
+    int num_vertex = 0;
+    int num_edges = 0;
+    float density = 0.0;
+    Adjacency adj;
+    std::unique_ptr<Reduction> reduction;
+    std::unique_ptr<VertexOrdering> ordering;
+    std::unique_ptr<ComponentDecomposition> decomposition;
+    vector<pair<int, int>> searchEdges;
+    int searchOrder = 0;
+    int searchBound = 0;
+    std::vector<int> componentBounds;   // searchBound, component by component
+    int bound = 0;
+    int target = -1;
+    double preprocessingTime = 0.0;
+};
+
+std::unique_ptr<PreparedGraph> prepareGraph(const Parameters& params, const std::string& path,
+    const std::map<std::string, int>& knownOptima, bool verbose) {
+
+    auto prepared = std::make_unique<PreparedGraph>();
+    PreparedGraph& p = *prepared;
+
+    vector<pair<int, int>> edges;
+    readEdgeList(path, p.num_vertex, p.num_edges, edges);
+
+    p.graphName = fs::path (path).stem().string();
+    p.density = static_cast<float>(2 * p.num_edges) / (p.num_vertex * (p.num_vertex - 1));
+
+    // Optional exact preprocessing: the GA runs on the kernel and the best
+    // labelling is lifted back to the input graph
+    p.adj = buildAdjacency(p.num_vertex, edges);
+    if(params.reduce){
+        auto begin = std::chrono::high_resolution_clock::now();
+        p.reduction = std::make_unique<Reduction>(p.adj);
+        p.reduction->apply();
+        p.preprocessingTime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count();
+
+        #if !IRACE
+        if(verbose) p.reduction->printSummary(std::cout);
+        #endif
+    }
+
+    // Optional relabelling of the graph the GA searches, for locality; its
+    // labellings are mapped back before the lift
+    if(params.order != VertexOrder::NONE){
+        auto begin = std::chrono::high_resolution_clock::now();
+        p.ordering = std::make_unique<VertexOrdering>(params.reduce ? p.reduction->kernel() : p.adj, params.order);
+        p.preprocessingTime += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count();
+
+        #if !IRACE
+        if(verbose) std::cout << "Vertex order " << vertexOrderName(params.order) << ": bandwidth "
+            << p.ordering->originalBandwidth() << " -> " << p.ordering->bandwidth() << std::endl;
+        #endif
+    }
+    const Adjacency& search = p.ordering ? p.ordering->graph() : params.reduce ? p.reduction->kernel() : p.adj;
+
+    // Lower bound on the graph the GA searches: a run that reaches it is optimal.
+    // Its cost is capped by the exact-time budget of lowerBound, and is not
+    // part of the run time.
+    p.componentBounds = componentLowerBounds(search);
+    p.searchBound = std::accumulate(p.componentBounds.begin(), p.componentBounds.end(), 0);
+    p.bound = p.searchBound + (params.reduce ? p.reduction->fixedWeight() : 0);
+
+    // Optional target weight: the run stops at the first solution that reaches it
+    p.target = targetFor(p.graphName, params.targets.empty() ? -1 : params.targets.front(), knownOptima);
+
+    // Component mode solves every connected component on its own
+    if(params.components){
+        p.decomposition = std::make_unique<ComponentDecomposition>(search);
+    }
+    p.searchEdges = (params.reduce || p.ordering) ? edgeList(search) : edges;
+    p.searchOrder = search.size();
+    return prepared;
+}
+
+// One run of the whole pipeline. Every run labels the nodes of its own copy
+// of the graph, so runs on the same prepared graph can go in parallel.
+Result runTrial(const Parameters& params, const PreparedGraph& p, unsigned long seed, int threads, int run,
+    const std::string& tracePath, bool verbose) {
+
+    Result res = Result(p.graphName, p.num_vertex, p.num_edges, p.density, -1, -1);
+
+    if(p.decomposition != nullptr){
+        auto begin = std::chrono::high_resolution_clock::now();
+
+        ComponentStats stats;
+        std::vector<int> labels = solveByComponents(*p.decomposition,
+            [&](const Adjacency& component, int index) {
+                return solveWithGA(params, component, p.componentBounds[index], p.graphName, SeedSequence(seed).child(index).seed());
+            },
+            threads, &stats);
+        if(p.ordering != nullptr){
+            labels = p.ordering->restore(labels);
+        }
+        if(p.reduction != nullptr){
+            labels = p.reduction->lift(labels);
+        }
+        if(!isPerfectRoman(p.adj, labels)){
+            throw std::runtime_error("Stitched solution is not a perfect Roman dominating function: " + p.graphName);
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - begin).count();
+
+        #if !IRACE
+        if(verbose) stats.print(std::cout);
+        #endif
+
+        res = Result(p.graphName, p.num_vertex, p.num_edges, p.density, labelWeight(labels), elapsed + p.preprocessingTime);
+    }
+    // Everything was fixed by the reduction
+    else if(p.searchOrder == 0){
+        res = Result(p.graphName, p.num_vertex, p.num_edges, p.density, p.reduction->fixedWeight(), p.preprocessingTime);
+    }
+    else{
+        vector<pair<int, int>> searchEdges = p.searchEdges;
+        Graph g(p.searchOrder, searchEdges.size(), searchEdges, p.graphName);
+        GeneticAlgorithm* GA = new GeneticAlgorithm(&g, params.populationFactor, params.tournamentSize, params.maxStagnant, params.mutationRate, params.elitismRate, params.generations, seed,
+            params.graspRate, params.graspAlpha, threads);
+        GA->lowerBound = p.searchBound;
+        GA->steadyState = params.steadyState;
+        GA->target = (p.target >= 0 && params.reduce) ? std::max(p.target - p.reduction->fixedWeight(), -1) : p.target;
+
+        TraceSink* trace = nullptr;
+        if(!tracePath.empty()){
+            trace = new TraceSink(tracePath, run, params.reduce ? p.reduction->fixedWeight() : 0);
+            GA->trace = trace;
+        }
+    
+        res = GA->gaFlow();
+        delete trace;
+        res.elapsed_time += p.preprocessingTime;
+        if(res.time_to_target >= 0){
+            res.time_to_target += p.preprocessingTime;
+        }
+
+        // The best labelling in the ids of the input graph
+        if(p.reduction != nullptr || p.ordering != nullptr){
+            std::vector<int> labels = toInts(bestSolution(GA)->solution);
+            if(p.ordering != nullptr){
+                labels = p.ordering->restore(labels);
+            }
+            if(p.reduction != nullptr){
+                labels = p.reduction->lift(labels);
+            }
+            if(!isPerfectRoman(p.adj, labels)){
+                throw std::runtime_error("Lifted solution is not a perfect Roman dominating function: " + p.graphName);
+            }
+            res.graph_name = p.graphName;
+            res.node_count = p.num_vertex;
+            res.edge_count = p.num_edges;
+            res.graph_density = p.density;
+            res.fitness = labelWeight(labels);
+        }
+
+        delete GA;
+    }
+
+    res.lower_bound = p.bound;
+    // Component runs and runs settled by the reduction reach the target only at the end
+    if(p.target >= 0 && res.fitness <= p.target && res.time_to_target < 0){
+        res.time_to_target = res.elapsed_time;
+    }
+    return res;
+}
+
+void runGA(Parameters params, const std::string& path) {
+
+    std::map<std::string, int> knownOptima;
+    if(!params.known_optima.empty()){
+        knownOptima = readKnownOptima(params.known_optima);
+    }
+    std::unique_ptr<PreparedGraph> prepared = prepareGraph(params, path, knownOptima, true);
+    const std::string& graphName = prepared->graphName;
+
+    // TTT mode: many independent runs, spread over the threads, each stopping at
+    // the target. Every target gets an experiment of its own, on the same seeds.
+    const std::vector<int> targets = params.targets.empty() ? std::vector<int>{-1} : params.targets;
+    for(size_t t = 0; t < targets.size() && params.ttt > 0; t++){
+        prepared->target = targetFor(graphName, targets[t], knownOptima);
+        if(prepared->target < 0){
+            throw std::runtime_error("--ttt needs a target (--target or --known-optima): " + graphName);
+        }
+        PROFILE_RESET();
+        std::vector<TTTRun> runs = runTTT(params.ttt, SeedSequence(params.seed).child("ttt").seed(), params.threads, [&](int index, unsigned long seed) {
+            // The runs go in parallel, so each one traces to its own file
+            const std::string suffix = targets.size() > 1 ? "_" + std::to_string(prepared->target) + "_" + std::to_string(index)
+                : "_" + std::to_string(index);
+            const std::string tracePath = params.trace.empty() ? "" : tttPath(params.trace, suffix);
+            Result res = runTrial(params, *prepared, seed, 1, index, tracePath, false);
+            TTTRun run;
+            run.fitness = res.fitness;
+            run.elapsed_time = res.elapsed_time;
+            run.time_to_target = res.time_to_target;
+            return run;
+        });
+
+        writeTTTRuns(tttPath(params.output_file, "_ttt"), graphName, "GA", prepared->target, runs);
+        writeTTTPlot(tttPath(params.output_file, "_ttt_plot"), graphName, "GA", prepared->target, runs);
+        // The runs overlap, so the profile covers all of them (run -1)
+        PROFILE_REPORT(fs::path(params.output_file).replace_extension().string() + "_profile.json", graphName, "GA", -1);
+        #if !IRACE
+        printTTTSummary(std::cout, prepared->target, runs);
+        #endif
+    }
+
+    for(int trial = 0; trial < params.trials && params.ttt == 0; trial++){
+
+        PROFILE_RESET();
+        Result res = runTrial(params, *prepared, SeedSequence(params.seed).child(trial).seed(), params.threads, trial, params.trace, true);
+        PROFILE_REPORT(fs::path(params.output_file).replace_extension().string() + "_profile.json", graphName, "GA", trial);
+
+        #if !IRACE
+        write_result_to_csv(params.output_file, res);
+        #endif
+
+        #if IRACE
+        cout << res.fitness << endl;
+        #endif
+    }
+
+}
+
+// Batch mode: every trial of every graph of params.batch in one process. The
+// jobs run one GA each, on params.workers threads.
+void runBatchGA(const Parameters& params) {
+    if(params.ttt > 0){
+        throw std::runtime_error("--ttt and --batch cannot be combined");
+    }
+
+    std::map<std::string, int> knownOptima;
+    if(!params.known_optima.empty()){
+        knownOptima = readKnownOptima(params.known_optima);
+    }
+    const std::vector<std::string> paths = batchInstances(params.batch);
+    BatchWriter writer(params.output_file);
+
+    // The jobs overlap, so the profile covers all of them (run -1)
+    PROFILE_RESET();
+    runBatch<PreparedGraph>(paths, params.trials, params.workers, params.generations,
+        [&](const std::string& path) { return prepareGraph(params, path, knownOptima, false); },
+        [&](const PreparedGraph& prepared, const std::string&, int trial) {
+            const std::string tracePath = params.trace.empty() ? ""
+                : tttPath(params.trace, "_" + prepared.graphName + "_" + std::to_string(trial));
+            // Seeded by graph and trial, not by the order the jobs happen to run in
+            const unsigned long seed = SeedSequence(params.seed).child(prepared.graphName).child(trial).seed();
+            writer.write(csv_row(runTrial(params, prepared, seed, 1, trial, tracePath, false)));
+        });
+    PROFILE_REPORT(fs::path(params.output_file).replace_extension().string() + "_profile.json", "batch", "GA", -1);
+}
+
+// Server mode: answers evaluation requests for irace (see Common/Server.hpp)
+// on params.server, a socket path or "-" for stdin. The graphs of
+// params.instances are prepared at start-up, any other graph at its first
+// request; each evaluation is one GA run on one core.
+void runServerGA(const Parameters& params) {
+    std::map<std::string, int> knownOptima;
+    if(!params.known_optima.empty()){
+        knownOptima = readKnownOptima(params.known_optima);
+    }
+
+    // A prepared graph depends on the preprocessing options as well
+    auto cacheKey = [](const Parameters& p, const std::string& path) {
+        return fs::weakly_canonical(path).string() + (p.reduce ? " reduce" : "")
+            + (p.components ? " components" : "") + " " + vertexOrderName(p.order) + " " + std::to_string(p.targets.empty() ? -1 : p.targets.front());
+    };
+    std::mutex cacheMutex;
+    std::map<std::string, std::shared_ptr<const PreparedGraph>> cache;
+    if(!params.instances.empty()){
+        for(const std::string& path : batchInstances(params.instances)){
+            try{
+                cache[cacheKey(params, path)] = prepareGraph(params, path, knownOptima, false);
+            }catch(const std::exception& e){
+                std::cerr << "Skipping " << path << ": " << e.what() << std::endl;
+            }
+        }
+    }
+    std::cerr << "Serving " << cache.size() << " preloaded instances on " << params.server << std::endl;
+
+    RequestHandler handler = [&](const std::vector<std::string>& words) {
+        Parameters request = params;
+        request.seed = std::stoul(words[0]);
+        std::vector<std::string> options(words.begin() + 2, words.end());
+        std::vector<char*> argv;
+        for(std::string& option : options) argv.push_back(option.data());
+        for(int i = 0; i < static_cast<int>(argv.size()); i++){
+            if(!parse_option(request, argv.size(), argv.data(), i)){
+                throw std::runtime_error("unknown argument " + options[i]);
+            }
+        }
+
+        const std::string key = cacheKey(request, words[1]);
+        std::shared_ptr<const PreparedGraph> prepared;
+        {
+            std::lock_guard<std::mutex> lock(cacheMutex);
+            auto it = cache.find(key);
+            if(it != cache.end()) prepared = it->second;
+        }
+        if(prepared == nullptr){
+            prepared = prepareGraph(request, words[1], knownOptima, false);
+            std::lock_guard<std::mutex> lock(cacheMutex);
+            cache.emplace(key, prepared);
+        }
+
+        Result res = runTrial(request, *prepared, SeedSequence(request.seed).child(0).seed(), 1, 0, "", false);
+        std::ostringstream response;
+        response << res.fitness << " " << res.elapsed_time;
+        return response.str();
+    };
+
+    if(params.server == "-"){
+        serveStream(std::cin, std::cout, params.workers, handler);
+    }else{
+        serveSocket(params.server, params.workers, handler);
+    }
+}
+
+Solution* bestSolution(GeneticAlgorithm* GA) {
+    return *std::min_element(GA->population.begin(), GA->population.end(), [](Solution* a, Solution* b) { return *a < *b;});
+}
+
+// Runs one GA on a component, which stops at 'bound', and returns the labels of its best individual
+std::vector<int> solveWithGA(const Parameters& params, const Adjacency& adj, int bound, const std::string& name, unsigned long seed) {
+    vector<pair<int, int>> edges = edgeList(adj);
+    Graph g(adj.size(), edges.size(), edges, name);
+
+    GeneticAlgorithm GA(&g, params.populationFactor, params.tournamentSize, params.maxStagnant, params.mutationRate, params.elitismRate, params.generations, seed,
+        params.graspRate, params.graspAlpha);
+    GA.lowerBound = bound;
+    GA.steadyState = params.steadyState;
+    GA.gaFlow();
+
+    return toInts(bestSolution(&GA)->solution);
+}
+
+void ensure_csv_header(const std::string &filename) {
+    bool file_exists = std::filesystem::exists(filename);
+    std::ofstream file;
+    if (!file_exists) {
+        file.open(filename);
+        file << "graph_name,graph_order,graph_size,density,fitness_value,elapsed_time(seconds),lower_bound,gap,time_to_target\n";
+        file.close();
+    } 
+}
+
+std::string csv_row(const Result &result) {
+    std::ostringstream row;
+    row << result.graph_name << "," << result.node_count << ","
+        << result.edge_count << "," << result.graph_density << "," << result.fitness << ","
+        << result.elapsed_time << "," << result.lower_bound << ","
+        << relativeGap(result.fitness, result.lower_bound) << "," << result.time_to_target << "\n";
+    return row.str();
+}
+
+void write_result_to_csv(const std::string &filename, const Result &result) {
+    std::ofstream file(filename, std::ios::app);
+    file << csv_row(result);
+    file.close();
+}
+
+
+void printParameters(const Parameters& p) {
+    std::cout << "===== Genetic Algorithm Parameters =====\n";
+    std::cout << std::left;
+
+    std::cout << std::setw(20) << "Graph file:"       << p.file_path       << "\n";
+    std::cout << std::setw(20) << "Output file:"      << p.output_file     << "\n";
+    std::cout << std::setw(20) << "Generations:"      << p.generations     << "\n";
+    std::cout << std::setw(20) << "Max stagnant:"     << p.maxStagnant     << "\n";
+    std::cout << std::setw(20) << "Tournament size:"  << p.tournamentSize  << "\n";
+    std::cout << std::setw(20) << "Population factor:"<< p.populationFactor<< "\n";
+    std::cout << std::setw(20) << "Elitism rate:"     << p.elitismRate     << "\n";
+    std::cout << std::setw(20) << "Mutation rate:"    << p.mutationRate    << "\n";
+    std::cout << std::setw(20) << "GRASP rate:"       << p.graspRate       << "\n";
+    std::cout << std::setw(20) << "GRASP alpha:"      << p.graspAlpha      << "\n";
+    std::cout << std::setw(20) << "Total trials:"    << p.trials    << "\n";
+    std::cout << std::setw(20) << "Reduction:"       << p.reduce    << "\n";
+    std::cout << std::setw(20) << "Components:"      << p.components<< "\n";
+    std::cout << std::setw(20) << "Vertex order:"    << vertexOrderName(p.order) << "\n";
+    std::cout << std::setw(20) << "Threads:"         << p.threads   << "\n";
+    std::cout << std::setw(20) << "Steady state:"    << p.steadyState << "\n";
+    std::cout << std::setw(20) << "Seed:"            << p.seed      << "\n";
+    std::cout << std::setw(20) << "Targets:";
+    for (int target : p.targets) std::cout << " " << target;
+    std::cout << "\n";
+    std::cout << std::setw(20) << "Known optima:"    << p.known_optima << "\n";
+    std::cout << std::setw(20) << "TTT runs:"        << p.ttt       << "\n";
+    std::cout << std::setw(20) << "Trace file:"      << p.trace     << "\n";
+    std::cout << std::setw(20) << "Batch:"           << p.batch     << "\n";
+    std::cout << std::setw(20) << "Workers:"         << p.workers   << "\n";
+    std::cout << std::setw(20) << "Server:"          << p.server    << "\n";
+    std::cout << std::setw(20) << "Instances:"       << p.instances << "\n";
+    std::cout << "=========================================\n";
+}
+
+// Reads the option at argv[i] and its value, leaving i on the last word
+// read; false if the option is unknown
+bool parse_option(Parameters& parameters, int argc, char *argv[], int& i) {
+    std::string arg = argv[i];
+    if (arg == "--stagnation" && i + 1 < argc) {
+        parameters.maxStagnant = std::stoi(argv[++i]);
+
+    } else if (arg == "--generations" && i + 1 < argc) {
+        parameters.generations = std::stoi(argv[++i]);
+
+    } else if (arg == "--populationFactor" && i + 1 < argc) {
+        parameters.populationFactor = std::stoi(argv[++i]);
+
+    } else if (arg == "--tournament" && i + 1 < argc) {
+        parameters.tournamentSize = std::stoi(argv[++i]);
+
+    } else if (arg == "--elitism" && i + 1 < argc) {
+        parameters.elitismRate = std::stof(argv[++i]);
+
+    } else if (arg == "--mutation" && i + 1 < argc) {
+        parameters.mutationRate = std::stof(argv[++i]);
+
+    } else if (arg == "--grasp" && i + 1 < argc) {
+        parameters.graspRate = std::stof(argv[++i]);
+
+    } else if (arg == "--grasp-alpha" && i + 1 < argc) {
+        parameters.graspAlpha = std::stof(argv[++i]);
+
+    } else if (arg == "--output" && i + 1 < argc) {
+        parameters.output_file = argv[++i];
+
+    } else if (arg == "--trials" && i + 1 < argc) {
+        parameters.trials = std::stoi(argv[++i]);
+
+    } else if (arg == "--reduce") {
+        parameters.reduce = true;
+
+    } else if (arg == "--components") {
+        parameters.components = true;
+
+    } else if (arg == "--order" && i + 1 < argc) {
+        parameters.order = parseVertexOrder(argv[++i]);
+
+    } else if (arg == "--threads" && i + 1 < argc) {
+        parameters.threads = std::stoi(argv[++i]);
+
+    } else if (arg == "--steady-state") {
+        parameters.steadyState = true;
+
+    } else if (arg == "--seed" && i + 1 < argc) {
+        parameters.seed = std::stoul(argv[++i]);
+        parameters.drawnSeed = false;
+
+    } else if (arg == "--target" && i + 1 < argc) {
+        parameters.targets = parseTargets(argv[++i]);
+
+    } else if (arg == "--known-optima" && i + 1 < argc) {
+        parameters.known_optima = argv[++i];
+
+    } else if (arg == "--ttt" && i + 1 < argc) {
+        parameters.ttt = std::stoi(argv[++i]);
+
+    } else if (arg == "--trace" && i + 1 < argc) {
+        parameters.trace = argv[++i];
+
+    } else if (arg == "--workers" && i + 1 < argc) {
+        parameters.workers = std::stoi(argv[++i]);
+
+    } else if (arg == "--instances" && i + 1 < argc) {
+        parameters.instances = argv[++i];
+
+    } else {
+        return false;
+    }
+    return true;
+}
+
+Parameters parse_args(int argc, char *argv[]) {
+    Parameters parameters;
+
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <graph_file> [options]\n"
+                  << "       " << argv[0] << " --batch <directory|instance_list> [options]\n"
+                  << "       " << argv[0] << " --server <socket|-> [--instances <directory|instance_list>] [options]\n"
+                  << "Options:\n"
+                  << "  --crossover VALUE\n"
+                  << "  --stagnation VALUE\n"
+                  << "  --generations VALUE\n"
+                  << "  --populationFactor VALUE\n"
+                  << "  --tournament VALUE\n"
+                  << "  --elitism VALUE\n"
+                  << "  --mutation VALUE\n"
+                  << "  --grasp VALUE\n"
+                  << "  --grasp-alpha VALUE\n"
+                  << "  --trials VALUE\n"
+                  << "  --reduce\n"
+                  << "  --components\n"
+                  << "  --order none|rcm|degree|bfs\n"
+                  << "  --threads VALUE\n"
+                  << "  --steady-state\n"
+                  << "  --seed VALUE\n"
+                  << "  --target VALUE[,VALUE...]\n"
+                  << "  --known-optima FILE\n"
+                  << "  --ttt RUNS\n"
+                  << "  --trace FILE\n"
+                  << "  --workers VALUE\n"
+                  << "  --output FILE\n";
+        exit(1);
+      }
+
+    #if !IRACE
+    int first = 2;
+    if (std::string(argv[1]) == "--batch" && argc > 2) {
+        parameters.batch = argv[2];
+        first = 3;
+    } else if (std::string(argv[1]) == "--server" && argc > 2) {
+        parameters.server = argv[2];
+        first = 3;
+    } else {
+        parameters.file_path = argv[1];
+    }
+
+    for (int i = first; i < argc; i++) {
+        if (!parse_option(parameters, argc, argv, i)) {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            exit(1);
+        }
+    }
+
+    #endif
+
+    #if IRACE
+
+    parameters.seed = std::stoul(argv[3]);              // seed for random number generator
+    parameters.file_path = argv[4];                     // path for instance
+    
+    for (int i = 5; i < argc; i++) {
+        if (!parse_option(parameters, argc, argv, i)) {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            exit(1);
+        }
+    }
+
+    #endif
+
+    // A normal run stops at one target
+    if (parameters.targets.size() > 1 && parameters.ttt == 0) {
+        std::cerr << "Several targets need --ttt" << std::endl;
+        exit(1);
+    }
+
+    return parameters;
 }
\ No newline at end of file